@@ -0,0 +1,105 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench.h"
+
+/**
+ * Usage: bench [max_count [max_bytes]]
+ *
+ * Prints one CSV record per (implementation, operation, element size,
+ * element count) to stdout:
+ *
+ *   impl,op,elem_size,count,ops,ns,ns_per_op
+ *
+ * Element counts run from 10 to `max_count` (default 10^8) in powers of ten,
+ * combinations where `count * elem_size` exceeds `max_bytes` (default
+ * 256 MiB) are skipped.
+ */
+
+/* minimum number of operations per record (small counts are repeated) */
+#define BENCH_MIN_OPS ((size_t)1 << 20)
+
+/* maximum number of bytes shifted by insert/erase per record */
+#define BENCH_SHIFT_BYTES ((size_t)1 << 28)
+
+static volatile size_t sink;
+
+uint64_t bench_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+size_t bench_reps(size_t n) {
+	return (n >= BENCH_MIN_OPS) ? 1 : (BENCH_MIN_OPS + n - 1) / n;
+}
+
+size_t bench_shift_ops(size_t n, size_t elem_size) {
+	size_t ops = BENCH_SHIFT_BYTES / (n * elem_size);
+	if (ops < 1) {
+		return 1;
+	}
+	return (ops > BENCH_MIN_OPS) ? BENCH_MIN_OPS : ops;
+}
+
+void bench_sink(size_t value) {
+	sink += value;
+}
+
+void bench_report(
+	const char* impl, const char* op, size_t elem_size, size_t count,
+	size_t ops, uint64_t ns
+) {
+	printf(
+		"%s,%s,%zu,%zu,%zu,%" PRIu64 ",%.3f\n",
+		impl, op, elem_size, count, ops, ns, (double)ns / (double)ops
+	);
+	fflush(stdout);
+}
+
+typedef void (*bench_fn)(size_t n);
+
+typedef struct {
+	size_t elem_size;
+	bench_fn fns[5];
+} bench_case;
+
+#define BENCH_CASE(size)                                                      \
+	{size, {                                                              \
+		bench_da_##size, bench_da_noerr_##size, bench_any_##size,     \
+		bench_raw_##size, bench_vector_##size,                        \
+	}},
+
+static const bench_case cases[] = {
+	BENCH_ELEM_SIZES(BENCH_CASE)
+};
+
+int main(int argc, char** argv) {
+	size_t max_count = 100000000;
+	size_t max_bytes = (size_t)1 << 28;
+
+	if (argc > 1) {
+		max_count = strtoull(argv[1], NULL, 10);
+	}
+	if (argc > 2) {
+		max_bytes = strtoull(argv[2], NULL, 10);
+	}
+
+	printf("impl,op,elem_size,count,ops,ns,ns_per_op\n");
+
+	size_t num_cases = sizeof(cases) / sizeof(cases[0]);
+	for (size_t c = 0; c < num_cases; ++c) {
+		for (size_t n = 10; n <= max_count; n *= 10) {
+			if (n * cases[c].elem_size > max_bytes) {
+				break;
+			}
+			for (size_t f = 0; f < 5; ++f) {
+				cases[c].fns[f](n);
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The element sizes (in bytes) under test.
+ *
+ * Each implementation is compiled once per element size, see `da.c` and
+ * `vector.cpp`.
+ *
+ * @param         X	macro "called" with each element size
+ */
+#define BENCH_ELEM_SIZES(X)                                                   \
+	X(1) X(2) X(4) X(8) X(16) X(32) X(64) X(128) X(256)
+
+/**
+ * Declares the benchmark functions for a single element size.
+ *
+ * @param         size	element size, in bytes
+ */
+#define BENCH_DECLARE(size)                                                   \
+	void bench_da_##size(size_t n);                                       \
+	void bench_da_noerr_##size(size_t n);                                 \
+	void bench_any_##size(size_t n);                                      \
+	void bench_raw_##size(size_t n);                                      \
+	void bench_vector_##size(size_t n);
+
+BENCH_ELEM_SIZES(BENCH_DECLARE)
+
+/**
+ * Monotonic clock, in nanoseconds.
+ */
+uint64_t bench_now(void);
+
+/**
+ * Number of repetitions required for a test over `n` elements to perform at
+ * least the minimum number of operations.
+ *
+ * @param         n	element count
+ */
+size_t bench_reps(size_t n);
+
+/**
+ * Number of operations to time for operations that shift the tail of an
+ * array (insert, erase), these are capped by the number of bytes moved.
+ *
+ * @param         n        	element count
+ * @param         elem_size	element size, in bytes
+ */
+size_t bench_shift_ops(size_t n, size_t elem_size);
+
+/**
+ * Consumes a value so that the compiler cannot discard the work that
+ * produced it.
+ *
+ * @param         value	any value
+ */
+void bench_sink(size_t value);
+
+/**
+ * Prints a single CSV record.
+ *
+ * @param         impl     	name of the implementation
+ * @param         op       	name of the operation
+ * @param         elem_size	element size, in bytes
+ * @param         count    	element count
+ * @param         ops      	number of operations timed
+ * @param         ns       	total time, in nanoseconds
+ */
+void bench_report(
+	const char* impl, const char* op, size_t elem_size, size_t count,
+	size_t ops, uint64_t ns
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_BENCH_H_ */
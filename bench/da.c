@@ -0,0 +1,420 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+/**
+ * This file is compiled once per element size, `BENCH_ELEM_SIZE` is set by
+ * the Makefile.
+ *
+ * It is compiled a second time with `DA_NO_ERRORS` defined, in which case only
+ * the da.h tests are built, and reported as "da_noerr".
+ */
+#ifndef BENCH_ELEM_SIZE
+#error "BENCH_ELEM_SIZE is not defined"
+#endif
+
+typedef struct {
+	unsigned char bytes[BENCH_ELEM_SIZE];
+} elem_type;
+
+/* `DA_GET` requires a "zero" value of the same type as the elements */
+#define DA_ZERO (elem_type){{0}}
+#include "da.h"
+#include "da_any.h"
+#include "da_vm.h"
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCH_FN(prefix) BENCH_CONCAT(prefix, BENCH_ELEM_SIZE)
+
+#define BENCH_REPORT(impl, op, n, ops, t0)                                    \
+	bench_report(impl, op, BENCH_ELEM_SIZE, n, ops, bench_now() - (t0))
+
+#ifdef DA_NO_ERRORS
+#define BENCH_DA "da_noerr"
+#define BENCH_DA_FN BENCH_FN(bench_da_noerr_)
+#else
+#define BENCH_DA "da"
+#define BENCH_DA_FN BENCH_FN(bench_da_)
+#endif
+
+static elem_type make_elem(size_t i) {
+	elem_type e = {{0}};
+	e.bytes[0] = (unsigned char)i;
+	return e;
+}
+
+/** da.h *********************************************************************/
+
+DA_DEFINE(elem_array, elem_type);
+
+/* the floating point growth curve that preceded DA_FACTOR_NUM/DEN */
+static size_t float_growth(
+	const da_growth_type* growth, size_t capacity, size_t required
+) {
+	(void)growth;
+	(void)required;
+	return (size_t)(capacity * 1.5);
+}
+
+void BENCH_DA_FN(size_t n) {
+	size_t reps = bench_reps(n);
+	size_t shift_ops = bench_shift_ops(n, BENCH_ELEM_SIZE);
+	uint64_t t0 = 0;
+	size_t acc = 0;
+	elem_array da;
+
+	/* push_back */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE(da);
+		for (size_t i = 0; i < n; ++i) {
+			DA_PUSH_BACK(da, make_elem(i));
+		}
+		acc += DA_BACK(da).bytes[0];
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "push_back", n, reps * n, t0);
+
+	/* push_back_unchecked */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE(da);
+		DA_RESERVE(da, n);
+		for (size_t i = 0; i < n; ++i) {
+			DA_PUSH_BACK_UNCHECKED(da, make_elem(i));
+		}
+		acc += DA_BACK(da).bytes[0];
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "push_back_unchecked", n, reps * n, t0);
+
+	/* push_back_fn: DA_DEFINE, growth out of line */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		elem_array_create(&da);
+		for (size_t i = 0; i < n; ++i) {
+			elem_array_push_back(&da, make_elem(i));
+		}
+		acc += DA_BACK(da).bytes[0];
+		elem_array_destroy(&da);
+	}
+	BENCH_REPORT(BENCH_DA, "push_back_fn", n, reps * n, t0);
+
+	/* push_back_x1.5: floating point vs. rational growth, same path */
+	static const da_growth_type growth_float =
+		DA_GROWTH_CUSTOM(float_growth, NULL);
+	static const da_growth_type growth_ratio = DA_GROWTH_GEOMETRIC(3, 2, 0);
+	const da_growth_type* growths[] = { &growth_float, &growth_ratio };
+	const char* growth_ops[] = {
+		"push_back_x1.5_float", "push_back_x1.5_ratio"
+	};
+	for (size_t g = 0; g < 2; ++g) {
+		t0 = bench_now();
+		for (size_t r = 0; r < reps; ++r) {
+			DA_CREATE(da);
+			DA_SET_GROWTH(da, growths[g]);
+			for (size_t i = 0; i < n; ++i) {
+				DA_PUSH_BACK(da, make_elem(i));
+			}
+			acc += DA_BACK(da).bytes[0];
+			DA_DESTROY(da);
+		}
+		BENCH_REPORT(BENCH_DA, growth_ops[g], n, reps * n, t0);
+	}
+
+#ifdef MREMAP_MAYMOVE
+	/* push_back_mremap: every block is mapped, to find the crossover */
+	size_t threshold = 0;
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE_WITH(da, &da_mremap_allocator, &threshold);
+		for (size_t i = 0; i < n; ++i) {
+			DA_PUSH_BACK(da, make_elem(i));
+		}
+		acc += DA_BACK(da).bytes[0];
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "push_back_mremap", n, reps * n, t0);
+#endif
+
+	DA_CREATE(da);
+	DA_RESIZE(da, n);
+	/* room for the insert test to double the size */
+	DA_RESERVE(da, 2 * n);
+
+	/* get */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			acc += (DA_GET(da, i)).bytes[0];
+		}
+	}
+	BENCH_REPORT(BENCH_DA, "get", n, reps * n, t0);
+
+	/* get_unchecked */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			acc += DA_GET_UNCHECKED(da, i).bytes[0];
+		}
+	}
+	BENCH_REPORT(BENCH_DA, "get_unchecked", n, reps * n, t0);
+
+	/* set */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			DA_SET(da, i, make_elem(i + r));
+		}
+	}
+	BENCH_REPORT(BENCH_DA, "set", n, reps * n, t0);
+
+	/* insert: in the middle, each round grows the array from n to 2n */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; DA_SIZE(da) = n) {
+		for (size_t i = 0; i < n && done < shift_ops; ++i, ++done) {
+			da_iter_type(da) it = DA_BEGIN(da) + DA_SIZE(da) / 2;
+			DA_INSERT(da, it, make_elem(i));
+		}
+	}
+	BENCH_REPORT(BENCH_DA, "insert", n, shift_ops, t0);
+
+	/* erase: in the middle, each round shrinks the array from n to n/2 */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; DA_SIZE(da) = n) {
+		for (size_t i = 0; i < n / 2 + 1 && done < shift_ops; ++i) {
+			da_iter_type(da) it = DA_BEGIN(da) + DA_SIZE(da) / 2;
+			DA_ERASE(da, it);
+			++done;
+		}
+	}
+	BENCH_REPORT(BENCH_DA, "erase", n, shift_ops, t0);
+
+	/* clear: a single store, so a batch is timed rather than each clear */
+	DA_SIZE(da) = n;
+	t0 = bench_now();
+	for (size_t r = 0; r < reps * n; ++r) {
+		DA_CLEAR(da);
+		bench_sink(DA_SIZE(da));
+	}
+	BENCH_REPORT(BENCH_DA, "clear", n, reps * n, t0);
+
+	acc += DA_SIZE(da);
+	DA_DESTROY(da);
+
+	/* reserve */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE(da);
+		DA_RESERVE(da, n);
+		acc += DA_CAPACITY(da);
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "reserve", n, reps, t0);
+
+	/* resize */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE(da);
+		DA_RESIZE(da, n);
+		acc += DA_BACK(da).bytes[0];
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "resize", n, reps, t0);
+
+	/* resize_uninit */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		DA_CREATE(da);
+		DA_RESIZE_UNINIT(da, n);
+		acc += DA_SIZE(da);
+		DA_DESTROY(da);
+	}
+	BENCH_REPORT(BENCH_DA, "resize_uninit", n, reps, t0);
+
+	bench_sink(acc);
+}
+
+/** da_any.h *****************************************************************/
+
+#ifndef DA_NO_ERRORS
+
+void BENCH_FN(bench_any_)(size_t n) {
+	size_t reps = bench_reps(n);
+	size_t shift_ops = bench_shift_ops(n, BENCH_ELEM_SIZE);
+	uint64_t t0 = 0;
+	size_t acc = 0;
+	da_any_type da;
+
+	/* push_back */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		da_any_create(&da, sizeof(elem_type));
+		for (size_t i = 0; i < n; ++i) {
+			elem_type e = make_elem(i);
+			da_any_push_back(&da, &e);
+		}
+		acc += ((elem_type*)da_any_get(&da, n - 1))->bytes[0];
+		da_any_destroy(&da);
+	}
+	BENCH_REPORT("da_any", "push_back", n, reps * n, t0);
+
+	da_any_create(&da, sizeof(elem_type));
+	/* room for the insert test to double the size */
+	da_any_reserve(&da, 2 * n);
+	for (size_t i = 0; i < n; ++i) {
+		elem_type e = make_elem(i);
+		da_any_push_back(&da, &e);
+	}
+
+	/* get */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			acc += ((elem_type*)da_any_get(&da, i))->bytes[0];
+		}
+	}
+	BENCH_REPORT("da_any", "get", n, reps * n, t0);
+
+	/* insert: in the middle, each round grows the array from n to 2n */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; da.size = n) {
+		for (size_t i = 0; i < n && done < shift_ops; ++i, ++done) {
+			elem_type e = make_elem(i);
+			da_any_insert(&da, DA_SIZE(da) / 2, &e);
+		}
+	}
+	BENCH_REPORT("da_any", "insert", n, shift_ops, t0);
+
+	/* erase: in the middle, each round shrinks the array from n to n/2 */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; da.size = n) {
+		for (size_t i = 0; i < n / 2 + 1 && done < shift_ops; ++i) {
+			da_any_erase(&da, DA_SIZE(da) / 2);
+			++done;
+		}
+	}
+	BENCH_REPORT("da_any", "erase", n, shift_ops, t0);
+
+	da_any_destroy(&da);
+	bench_sink(acc);
+}
+
+#endif /* DA_NO_ERRORS */
+
+/** malloc'd array ***********************************************************/
+
+#ifndef DA_NO_ERRORS
+
+void BENCH_FN(bench_raw_)(size_t n) {
+	size_t reps = bench_reps(n);
+	size_t shift_ops = bench_shift_ops(n, BENCH_ELEM_SIZE);
+	uint64_t t0 = 0;
+	size_t acc = 0;
+	elem_type* data = NULL;
+	size_t size = 0;
+	size_t capacity = 0;
+
+	/* push_back, doubling capacity */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		data = NULL;
+		size = 0;
+		capacity = 0;
+		for (size_t i = 0; i < n; ++i) {
+			if (size == capacity) {
+				capacity = capacity ? capacity * 2 : 1;
+				data = realloc(data, capacity * sizeof(*data));
+			}
+			data[size++] = make_elem(i);
+		}
+		acc += data[size - 1].bytes[0];
+		free(data);
+	}
+	BENCH_REPORT("raw", "push_back", n, reps * n, t0);
+
+	/* room for the insert test to double the size */
+	capacity = 2 * n;
+	data = calloc(capacity, sizeof(*data));
+	size = n;
+
+	/* get */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			acc += data[i].bytes[0];
+		}
+	}
+	BENCH_REPORT("raw", "get", n, reps * n, t0);
+
+	/* set */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			data[i] = make_elem(i + r);
+		}
+	}
+	BENCH_REPORT("raw", "set", n, reps * n, t0);
+
+	/* insert */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; size = n) {
+		for (size_t i = 0; i < n && done < shift_ops; ++i, ++done) {
+			elem_type* it = data + size / 2;
+			memmove(it + 1, it, (size - size / 2) * sizeof(*data));
+			*it = make_elem(i);
+			++size;
+		}
+	}
+	BENCH_REPORT("raw", "insert", n, shift_ops, t0);
+
+	/* erase */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; size = n) {
+		for (size_t i = 0; i < n / 2 + 1 && done < shift_ops; ++i) {
+			elem_type* it = data + size / 2;
+			size_t tail = size - size / 2 - 1;
+			memmove(it, it + 1, tail * sizeof(*data));
+			--size;
+			++done;
+		}
+	}
+	BENCH_REPORT("raw", "erase", n, shift_ops, t0);
+
+	/* clear */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps * n; ++r) {
+		size = 0;
+		bench_sink(size);
+	}
+	BENCH_REPORT("raw", "clear", n, reps * n, t0);
+
+	free(data);
+
+	/* reserve */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		data = malloc(n * sizeof(*data));
+		acc += (size_t)(data != NULL);
+		free(data);
+	}
+	BENCH_REPORT("raw", "reserve", n, reps, t0);
+
+	/* resize, from empty, new elements zero'd */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		data = malloc(n * sizeof(*data));
+		memset(data, 0, n * sizeof(*data));
+		acc += data[n - 1].bytes[0];
+		free(data);
+	}
+	BENCH_REPORT("raw", "resize", n, reps, t0);
+
+	bench_sink(acc);
+}
+
+#endif /* DA_NO_ERRORS */
@@ -0,0 +1,116 @@
+#include <cstring>
+#include <vector>
+
+#include "bench.h"
+
+/**
+ * `std::vector` equivalents of the tests in `da.c`.
+ */
+
+template <size_t S>
+struct elem_type {
+	unsigned char bytes[S];
+};
+
+template <size_t S>
+static elem_type<S> make_elem(size_t i) {
+	elem_type<S> e = {{0}};
+	e.bytes[0] = static_cast<unsigned char>(i);
+	return e;
+}
+
+template <size_t S>
+static void bench_vector(size_t n) {
+	size_t reps = bench_reps(n);
+	size_t shift_ops = bench_shift_ops(n, S);
+	uint64_t t0 = 0;
+	size_t acc = 0;
+
+	/* push_back */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		std::vector<elem_type<S>> v;
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back(make_elem<S>(i));
+		}
+		acc += v.back().bytes[0];
+	}
+	bench_report("vector", "push_back", S, n, reps * n, bench_now() - t0);
+
+	std::vector<elem_type<S>> v(n);
+	/* room for the insert test to double the size */
+	v.reserve(2 * n);
+
+	/* get */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			acc += v[i].bytes[0];
+		}
+	}
+	bench_report("vector", "get", S, n, reps * n, bench_now() - t0);
+
+	/* set */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			v[i] = make_elem<S>(i + r);
+		}
+	}
+	bench_report("vector", "set", S, n, reps * n, bench_now() - t0);
+
+	/* insert */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; v.resize(n)) {
+		for (size_t i = 0; i < n && done < shift_ops; ++i, ++done) {
+			v.insert(v.begin() + v.size() / 2, make_elem<S>(i));
+		}
+	}
+	bench_report("vector", "insert", S, n, shift_ops, bench_now() - t0);
+
+	/* erase */
+	t0 = bench_now();
+	for (size_t done = 0; done < shift_ops; v.resize(n)) {
+		for (size_t i = 0; i < n / 2 + 1 && done < shift_ops; ++i) {
+			v.erase(v.begin() + v.size() / 2);
+			++done;
+		}
+	}
+	bench_report("vector", "erase", S, n, shift_ops, bench_now() - t0);
+
+	/* clear: a single store for trivial elements, a batch is timed */
+	v.resize(n);
+	t0 = bench_now();
+	for (size_t r = 0; r < reps * n; ++r) {
+		v.clear();
+		bench_sink(v.size());
+	}
+	bench_report("vector", "clear", S, n, reps * n, bench_now() - t0);
+
+	/* reserve */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		std::vector<elem_type<S>> w;
+		w.reserve(n);
+		acc += w.capacity();
+	}
+	bench_report("vector", "reserve", S, n, reps, bench_now() - t0);
+
+	/* resize */
+	t0 = bench_now();
+	for (size_t r = 0; r < reps; ++r) {
+		std::vector<elem_type<S>> w;
+		w.resize(n);
+		acc += w.back().bytes[0];
+	}
+	bench_report("vector", "resize", S, n, reps, bench_now() - t0);
+
+	bench_sink(acc);
+}
+
+#define BENCH_DEFINE_VECTOR(size)                                             \
+	void bench_vector_##size(size_t n) {                                  \
+		bench_vector<size>(n);                                        \
+	}
+
+BENCH_ELEM_SIZES(BENCH_DEFINE_VECTOR)
@@ -0,0 +1,13 @@
+#include <stdio.h>
+#include "da.h"
+int main(void) {
+	da_type(int) da;
+	DA_CREATE(da);
+	DA_PUSH_BACK(da, 7);
+	DA_RESIZE(da, DA_SIZE(da) + 4);
+	printf("size=%zu err=%d:", da.size, da.errnum);
+	for (size_t i = 0; i < da.size; ++i) printf(" %d", da.data[i]);
+	printf("\n");
+	DA_DESTROY(da);
+	return 0;
+}
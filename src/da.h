@@ -1,8 +1,10 @@
 #ifndef UTILITY_DA_H_
 #define UTILITY_DA_H_
 
+#include <assert.h>
 #include <math.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,10 +17,23 @@
 #endif
 
 /**
- * The rate at which the array grows.
+ * The rate at which the array grows, as the rational `DA_FACTOR_NUM /
+ * DA_FACTOR_DEN`, growth is computed with integer arithmetic only.
+ *
+ * For compatibility, if `DA_FACTOR` is defined instead (e.g. to `1.5`) it is
+ * converted to a rational with a denominator of 1024 at compile time.
  */
-#ifndef DA_FACTOR
-#define DA_FACTOR 2
+#ifndef DA_FACTOR_NUM
+#ifdef DA_FACTOR
+#define DA_FACTOR_NUM ((size_t)((DA_FACTOR) * 1024))
+#define DA_FACTOR_DEN 1024
+#else
+#define DA_FACTOR_NUM 2
+#endif
+#endif
+
+#ifndef DA_FACTOR_DEN
+#define DA_FACTOR_DEN 1
 #endif
 
 /**
@@ -28,6 +43,19 @@
 #define DA_BIAS 0
 #endif
 
+/**
+ * Opt-in, not defined by default: the erasers (`DA_ERASE`, `DA_ERASE_RANGE`,
+ * `DA_ERASE_INDICES`, `DA_SWAP_REMOVE` and `DA_ERASE_IF`) halve the capacity
+ * (repeatedly) while the size is below `1 / DA_AUTO_SHRINK` of it, which
+ * invalidates all pointers and iterators into the array.
+ *
+ * A shrunk array is at most half full, so it must grow by a factor of two
+ * before it can shrink again; the fraction must be greater than 2.
+ */
+#if defined(DA_AUTO_SHRINK) && DA_AUTO_SHRINK <= 2
+#error "DA_AUTO_SHRINK must be greater than 2"
+#endif
+
 /**
  * This value is used as the "zero" value for new elements by DA_RESIZE.
  *
@@ -38,6 +66,59 @@
 #define DA_ZERO 0
 #endif
 
+/**
+ * The default allocator, used by every dynamic array that was not given its
+ * own with `DA_CREATE_WITH`.
+ *
+ * These may be defined before the header is included to route all storage to
+ * another allocator, e.g. jemalloc, they must behave as the standard library
+ * functions.
+ */
+#ifndef DA_MALLOC
+#define DA_MALLOC(size) malloc(size)
+#endif
+
+#ifndef DA_REALLOC
+#define DA_REALLOC(ptr, size) realloc(ptr, size)
+#endif
+
+#ifndef DA_FREE
+#define DA_FREE(ptr) free(ptr)
+#endif
+
+/**
+ * Opt-in, not defined by default: the number of usable bytes in a block
+ * returned by `DA_MALLOC` or `DA_REALLOC`, e.g. with glibc:
+ *
+ *     #include <malloc.h>
+ *     #define DA_USABLE_SIZE(ptr) malloc_usable_size(ptr)
+ *
+ * If defined, arrays that use the default allocator round each growth up to
+ * an allocator size class, and take the whole usable block as their capacity.
+ */
+
+/**
+ * Checks the preconditions of the "unchecked" macros, only if `DA_DEBUG` is
+ * defined (and `NDEBUG` is not).
+ */
+#ifdef DA_DEBUG
+#define DA_ASSERT(cond) assert(cond)
+#else
+#define DA_ASSERT(cond) ((void)0)
+#endif
+
+/**
+ * Marks a (`static`) function as a rarely taken path, kept out of line so that
+ * it is not copied into its callers, and a condition as rarely true.
+ */
+#if defined(__GNUC__)
+#define DA__COLD __attribute__((noinline, cold, unused))
+#define DA__UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#else
+#define DA__COLD
+#define DA__UNLIKELY(cond) (cond)
+#endif
+
 /** Errors *******************************************************************/
 
 /**
@@ -111,30 +192,303 @@ do {                                                                          \
 	(da).line = 0;                                                        \
 } while (0)
 
+/**
+ * Marks the successful completion of an operation.
+ *
+ * If `DA_NO_ERRORS` is defined before the header is included, successful
+ * operations do not reset the errnum, file and line of the array, so a
+ * successful `DA_GET` is a bounds check and a load, with no stores.
+ *
+ * Errors are still recorded, but are "sticky": `DA_ERRNO` reports the last
+ * error since the array was created or `DA_CLEAR_ERROR` was called.
+ *
+ * @param         da 	dynamic array
+ */
+#ifdef DA_NO_ERRORS
+#define DA__SUCCESS(da) do { } while (0)
+#else
+#define DA__SUCCESS(da) DA_CLEAR_ERROR(da)
+#endif
+
+/** Allocators ***************************************************************/
+
+/**
+ * A per-array allocator, see `DA_CREATE_WITH`.
+ *
+ * Both functions are given the context pointer that was passed to
+ * `DA_CREATE_WITH`, and the size (in bytes) of the current block, so that
+ * allocators without a size header (e.g. arenas) can be used.
+ *
+ * `reallocate` must behave as `realloc`: when `ptr` is `NULL` it allocates a
+ * new block, and on failure it returns `NULL` and leaves `ptr` untouched.
+ */
+typedef struct {
+	void* (*reallocate)(
+		void* ctx, void* ptr, size_t old_size, size_t new_size
+	);
+	void (*deallocate)(void* ctx, void* ptr, size_t size);
+} da_allocator_type;
+
+/**
+ * Resizes the block of the given dynamic array.
+ *
+ * @param         da      	dynamic array
+ * @param         ptr     	the current block
+ * @param         old_size	size of the current block, in bytes
+ * @param         new_size	size of the new block, in bytes
+ */
+#define DA__REALLOC(da, ptr, old_size, new_size)                              \
+	(                                                                     \
+		((da).allocator == NULL)                                      \
+		? DA_REALLOC(ptr, new_size)                                   \
+		: (da).allocator->reallocate(                                 \
+			(da).allocator_ctx, ptr, old_size, new_size           \
+		)                                                             \
+	)
+
+/**
+ * Frees the block of the given dynamic array.
+ *
+ * @param         da  	dynamic array
+ * @param         ptr 	the current block
+ * @param         size	size of the current block, in bytes
+ */
+#define DA__FREE(da, ptr, size)                                               \
+do {                                                                          \
+	if ((da).allocator == NULL) {                                         \
+		DA_FREE(ptr);                                                 \
+		break;                                                        \
+	}                                                                     \
+	(da).allocator->deallocate((da).allocator_ctx, ptr, size);            \
+} while (0)
+
+/**
+ * Rounds a block of `count` elements up to a size class: multiples of 16 bytes
+ * up to 128 bytes, then four classes per power of two (as jemalloc, and a
+ * superset of the glibc bins).
+ *
+ * @param         count    	number of elements
+ * @param         elem_size	size of an element, in bytes
+ *
+ * @return	the number of elements that fit in the size class
+ */
+static inline size_t da__size_class(size_t count, size_t elem_size) {
+	size_t step = 16;
+
+	if (count > SIZE_MAX / elem_size) {
+		return count;
+	}
+	size_t bytes = count * elem_size;
+	while (step * 8 <= bytes) {
+		step *= 2;
+	}
+	if (bytes > SIZE_MAX - (step - 1)) {
+		return count;
+	}
+	return (bytes + step - 1) / step * step / elem_size;
+}
+
+/**
+ * The capacity of a block of (at least) `count` elements, just (re)allocated
+ * for the given dynamic array.
+ *
+ * @param         da   	dynamic array
+ * @param         ptr  	the block
+ * @param         count	the number of elements requested
+ */
+#ifdef DA_USABLE_SIZE
+#define DA__USABLE_CAPACITY(da, ptr, count)                                   \
+	(                                                                     \
+		((da).allocator == NULL)                                      \
+		? DA_USABLE_SIZE(ptr) / sizeof((da).data[0])                  \
+		: (size_t)(count)                                             \
+	)
+#else
+#define DA__USABLE_CAPACITY(da, ptr, count) ((size_t)(count))
+#endif
+
+/** Growth Policies **********************************************************/
+
+/**
+ * The capacity that follows `capacity` on the curve given by `DA_FACTOR_NUM`,
+ * `DA_FACTOR_DEN` and `DA_BIAS`.
+ *
+ * @param         capacity	the current capacity
+ *
+ * @return	the next capacity, or 0 if it would overflow
+ */
+static inline size_t da__next_capacity(size_t capacity) {
+	size_t num = DA_FACTOR_NUM;
+	size_t den = DA_FACTOR_DEN;
+	size_t limit = (SIZE_MAX - (size_t)DA_BIAS) / num;
+
+	if (capacity <= limit) {
+		return capacity * num / den + (size_t)DA_BIAS;
+	}
+	/* divide first, rounding down by less than one factor */
+	if (capacity / den <= limit) {
+		return capacity / den * num + (size_t)DA_BIAS;
+	}
+	return 0;
+}
+
+typedef struct da_growth_type da_growth_type;
+
+/**
+ * A per-array growth policy, see `DA_SET_GROWTH`.
+ *
+ * `next` is "called" each time the array must grow, with the current capacity
+ * and the minimum capacity required, and returns the new capacity. A result
+ * smaller than `required` is raised to `required`.
+ *
+ * The remaining members are parameters for `next`, the policies below use
+ * `num`, `den`, `bias`, `threshold` and `step`, a custom policy may use `ctx`.
+ */
+struct da_growth_type {
+	size_t (*next)(
+		const da_growth_type* growth, size_t capacity, size_t required
+	);
+	void* ctx;
+	size_t num;
+	size_t den;
+	size_t bias;
+	size_t threshold;
+	size_t step;
+};
+
+/**
+ * `da_growth_type::next` for geometric growth, `capacity * num / den + bias`.
+ *
+ * Saturates to `required` if the new capacity would overflow.
+ */
+static inline size_t da_growth_geometric(
+	const da_growth_type* growth, size_t capacity, size_t required
+) {
+	if (capacity > (SIZE_MAX - growth->bias) / growth->num) {
+		return required;
+	}
+	return capacity * growth->num / growth->den + growth->bias;
+}
+
+/**
+ * `da_growth_type::next` for geometric growth up to `threshold` elements, and
+ * linear growth by `step` elements beyond it.
+ */
+static inline size_t da_growth_linear(
+	const da_growth_type* growth, size_t capacity, size_t required
+) {
+	if (capacity < growth->threshold) {
+		return da_growth_geometric(growth, capacity, required);
+	}
+	if (capacity > SIZE_MAX - growth->step) {
+		return required;
+	}
+	return capacity + growth->step;
+}
+
+/**
+ * Initialiser for a geometric growth policy.
+ *
+ * @param         num 	numerator of the growth factor
+ * @param         den 	denominator of the growth factor
+ * @param         bias	elements added after each growth
+ */
+#define DA_GROWTH_GEOMETRIC(num, den, bias)                                   \
+	{ da_growth_geometric, NULL, (num), (den), (bias), 0, 0 }
+
+/**
+ * Initialiser for a policy that grows geometrically (by `num / den`) up to
+ * `threshold` elements, and by `step` elements at a time beyond it.
+ *
+ * @param         num      	numerator of the growth factor
+ * @param         den      	denominator of the growth factor
+ * @param         bias     	elements added after each geometric growth
+ * @param         threshold	capacity at which growth becomes linear
+ * @param         step     	elements added by each linear growth
+ */
+#define DA_GROWTH_LINEAR(num, den, bias, threshold, step)                     \
+	{ da_growth_linear, NULL, (num), (den), (bias), (threshold), (step) }
+
+/**
+ * Initialiser for a custom growth policy.
+ *
+ * @param         fn 	a `da_growth_type::next` function
+ * @param         ctx	a context pointer for `fn`
+ */
+#define DA_GROWTH_CUSTOM(fn, ctx) { (fn), (ctx), 1, 1, 0, 0, 0 }
+
+/**
+ * Doubles the capacity, as the default `DA_FACTOR_NUM / DA_FACTOR_DEN`.
+ */
+static const da_growth_type da_growth_double = DA_GROWTH_GEOMETRIC(2, 1, 0);
+
+/**
+ * Grows by just under the golden ratio, `21 / 13`, so that the blocks freed by
+ * earlier growths can eventually be reused by the array.
+ */
+static const da_growth_type da_growth_golden = DA_GROWTH_GEOMETRIC(21, 13, 1);
+
+/**
+ * Sets the growth policy of the array, consulted each time the array grows
+ * (e.g. by `DA_PUSH_BACK` or `DA_INSERT`).
+ *
+ * The policy must outlive the array. `DA_CREATE` (and `DA_DESTROY`) reset the
+ * policy to `NULL`, which uses `DA_FACTOR_NUM / DA_FACTOR_DEN` and `DA_BIAS`.
+ *
+ * @param         da    	A dynamic array object.
+ * @param         policy	A pointer to a `da_growth_type`, may be `NULL`.
+ */
+#define DA_SET_GROWTH(da, policy)                                             \
+do {                                                                          \
+	(da).growth = (policy);                                               \
+} while (0)
+
 /** Dynamic Array ************************************************************/
 
 /**
- * The dynamic array object, these members should not be modified directly.
+ * The members common to every dynamic array object.
  *
  * @param         value_type	the type of the array element
  */
-#define da_type(value_type)                                                   \
-struct {                                                                      \
+#define DA__MEMBERS(value_type)                                               \
 	value_type*  data;                                                    \
 	size_t size;                                                          \
 	size_t capacity;                                                      \
+	/* NULL for the default allocator */                                  \
+	const da_allocator_type* allocator;                                   \
+	void* allocator_ctx;                                                  \
+	/* NULL for DA_FACTOR_NUM/DEN and DA_BIAS */                          \
+	const da_growth_type* growth;                                         \
 	/* for error reporting */                                             \
-	da_errno_type errnum;                                                 \
 	char* file;                                                           \
 	int line;                                                             \
+	da_errno_type errnum;
+
+/**
+ * The dynamic array object, these members should not be modified directly.
+ *
+ * @param         value_type	the type of the array element
+ */
+#define da_type(value_type)                                                   \
+struct {                                                                      \
+	DA__MEMBERS(value_type)                                               \
 }
 
 /**
- * Allocates the initial chunk of memory for the array.
+ * A constant initialiser for an empty dynamic array, equivalent to
+ * `DA_CREATE`, e.g. `da_type(int) da = DA_INIT;`.
+ *
+ * A zero-initialised dynamic array is also a valid, empty, array. Neither
+ * applies to small or static arrays, which must be created.
+ */
+#define DA_INIT { NULL, 0, 0, NULL, NULL, NULL, NULL, 0, DA_SUCCESS }
+
+/**
+ * Initialises an empty array, nothing is allocated until the first element is
+ * added (the first allocation holds at least `DA_INITIAL_CAPACITY` elements).
  *
  * Possible error values:
  * - `DA_SUCCESS`
- * - `DA_OUT_OF_MEMORY
  *
  * NOTE: "Calling" `DA_CREATE` on a dynamic array that already has memory
  * allocated to it will drop the current pointer without `free`'ing the memory.
@@ -143,19 +497,36 @@ struct {                                                                      \
  *
  * @param         da	A dynamic array object.
  *
+ * @see	`DA_CREATE_WITH`
  * @see	`DA_DESTROY`
  */
-#define DA_CREATE(da)                                                         \
+#define DA_CREATE(da) DA_CREATE_WITH(da, NULL, NULL)
+
+/**
+ * As `DA_CREATE`, the array will allocate all of its memory through the given
+ * allocator.
+ *
+ * The allocator (and context) must outlive the array.
+ *
+ * @param         da   	A dynamic array object.
+ * @param         alloc	A pointer to a `da_allocator_type`, may be
+ *                    	`NULL`.
+ * @param         ctx  	The context pointer passed to the allocator.
+ *
+ * @see	`da_allocator_type`
+ * @see	`DA_DESTROY`
+ */
+#define DA_CREATE_WITH(da, alloc, ctx)                                        \
 do {                                                                          \
-	(da).data = calloc(DA_INITIAL_CAPACITY, sizeof((da).data[0]));        \
+	(da).allocator = (alloc);                                             \
+	(da).allocator_ctx = (ctx);                                           \
+	(da).growth = NULL;                                                   \
+	(da).data = NULL;                                                     \
 	(da).size = 0;                                                        \
-	(da).capacity = DA_INITIAL_CAPACITY;                                  \
+	(da).capacity = 0;                                                    \
 	(da).errnum = DA_SUCCESS;                                             \
 	(da).file = NULL;                                                     \
 	(da).line = 0;                                                        \
-	if ((da).data == NULL) {                                              \
-		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
-	}                                                                     \
 } while (0)
 
 /**
@@ -172,10 +543,15 @@ do {                                                                          \
  */
 #define DA_DESTROY(da)                                                        \
 do {                                                                          \
-	free((da).data);                                                      \
+	if ((da).data != NULL) {                                              \
+		DA__FREE(da, (da).data, (da).capacity * sizeof((da).data[0]));\
+	}                                                                     \
 	(da).data = NULL;                                                     \
 	(da).size = 0;                                                        \
 	(da).capacity = 0;                                                    \
+	(da).allocator = NULL;                                                \
+	(da).allocator_ctx = NULL;                                            \
+	(da).growth = NULL;                                                   \
 	(da).errnum = DA_SUCCESS;                                             \
 	(da).file = NULL;                                                     \
 	(da).line = 0;                                                        \
@@ -196,8 +572,22 @@ do {                                                                          \
  * @param         da 	A dynamic array object.
  * @param         idx	The index of the new element.
  */
+#ifdef DA_NO_ERRORS
 #define DA_GET(da, idx)                                                       \
-	(                                                                     \
+	((                                                                    \
+		/* size_t is unsigned */                                      \
+		(size_t)(idx) >= (da).size                                    \
+	) ? (                                                                 \
+		((da).errnum = DA_OUT_OF_BOUNDS),                             \
+		((da).file = __FILE__),                                       \
+		((da).line = __LINE__),                                       \
+		DA_ZERO                                                       \
+	) : (                                                                 \
+		(da).data[idx]                                                \
+	))
+#else
+#define DA_GET(da, idx)                                                       \
+	((                                                                    \
 		/* size_t is unsigned */                                      \
 		(size_t)(idx) >= (da).size                                    \
 	) ? (                                                                 \
@@ -210,7 +600,8 @@ do {                                                                          \
 		((da).file = NULL),                                           \
 		((da).line = 0),                                              \
 		(da).data[idx]                                                \
-	)
+	))
+#endif
 
 /**
  * Array write with bounds checking.
@@ -230,7 +621,39 @@ do {                                                                          \
 		break;                                                        \
 	}                                                                     \
 	(da).data[idx] = elem;                                                \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Array read without bounds checking.
+ *
+ * The caller guarantees that `idx` is less than `DA_SIZE`, the errnum is not
+ * modified.
+ *
+ * @param         da 	A dynamic array object.
+ * @param         idx	An index into the array.
+ *
+ * @see `DA_ASSERT`
+ */
+#define DA_GET_UNCHECKED(da, idx)                                             \
+	(DA_ASSERT((size_t)(idx) < (da).size), (da).data[idx])
+
+/**
+ * Array write without bounds checking.
+ *
+ * The caller guarantees that `idx` is less than `DA_SIZE`, the errnum is not
+ * modified.
+ *
+ * @param         da  	A dynamic array object.
+ * @param         idx 	An index into the array.
+ * @param         elem	The new value of element.
+ *
+ * @see `DA_ASSERT`
+ */
+#define DA_SET_UNCHECKED(da, idx, elem)                                       \
+do {                                                                          \
+	DA_ASSERT((size_t)(idx) < (da).size);                                 \
+	(da).data[idx] = (elem);                                              \
 } while (0)
 
 /**
@@ -293,10 +716,103 @@ do {                                                                          \
  */
 #define DA_SIZE(da) (da).size
 
+/**
+ * Reallocates the block of a dynamic array to `n` elements, `n` must be
+ * greater than the current capacity. On failure the array is unchanged.
+ *
+ * Shared by every element type, and kept out of line, so that the macros that
+ * may grow the array only carry a call on their (rarely taken) slow path.
+ *
+ * @param         data         	pointer to the data pointer of the array
+ * @param         capacity     	pointer to the capacity of the array
+ * @param         n            	the new capacity
+ * @param         elem_size    	size of an element, in bytes
+ * @param         allocator    	the allocator of the array, may be `NULL`
+ * @param         allocator_ctx	the allocator context of the array
+ *
+ * @return	`DA_SUCCESS` or `DA_OUT_OF_MEMORY`
+ */
+static DA__COLD da_errno_type da__reserve(
+	void** data, size_t* capacity, size_t n, size_t elem_size,
+	const da_allocator_type* allocator, void* allocator_ctx
+) {
+	if (n > SIZE_MAX / elem_size) {
+		return DA_OUT_OF_MEMORY;
+	}
+	void* block = (allocator == NULL)
+		? DA_REALLOC(*data, n * elem_size)
+		: allocator->reallocate(
+			allocator_ctx, *data, *capacity * elem_size,
+			n * elem_size
+		);
+	/* on failure the old block is still valid */
+	if (block == NULL) {
+		return DA_OUT_OF_MEMORY;
+	}
+	/* new elements are left un-initialised */
+	*data = block;
+	*capacity = n;
+#ifdef DA_USABLE_SIZE
+	if (allocator == NULL) {
+		*capacity = DA_USABLE_SIZE(block) / elem_size;
+	}
+#endif
+	return DA_SUCCESS;
+}
+
+/**
+ * Grows the block of a dynamic array to hold at least `required` elements,
+ * following `growth`, or the curve of `da__next_capacity` if it is `NULL`.
+ * If that capacity cannot be allocated, exactly `required` is tried instead.
+ *
+ * @param         data         	pointer to the data pointer of the array
+ * @param         capacity     	pointer to the capacity of the array
+ * @param         required     	the minimum new capacity
+ * @param         elem_size    	size of an element, in bytes
+ * @param         allocator    	the allocator of the array, may be `NULL`
+ * @param         allocator_ctx	the allocator context of the array
+ * @param         growth       	the growth policy of the array, may be
+ *                              	`NULL`
+ *
+ * @return	`DA_SUCCESS` or `DA_OUT_OF_MEMORY`
+ */
+static DA__COLD da_errno_type da__grow(
+	void** data, size_t* capacity, size_t required, size_t elem_size,
+	const da_allocator_type* allocator, void* allocator_ctx,
+	const da_growth_type* growth
+) {
+	size_t n = (growth == NULL)
+		? da__next_capacity(*capacity)
+		: growth->next(growth, *capacity, required);
+
+	if (n < DA_INITIAL_CAPACITY) {
+		n = DA_INITIAL_CAPACITY;
+	}
+	if (n < required) {
+		n = required;
+	}
+#ifdef DA_USABLE_SIZE
+	if (allocator == NULL) {
+		n = da__size_class(n, elem_size);
+	}
+#endif
+	da_errno_type err = da__reserve(
+		data, capacity, n, elem_size, allocator, allocator_ctx
+	);
+	/* a bounded allocator (static, arena, vm) may still fit `required` */
+	if (err != DA_SUCCESS && n > required) {
+		err = da__reserve(
+			data, capacity, required, elem_size, allocator,
+			allocator_ctx
+		);
+	}
+	return err;
+}
+
 /**
  * Reserves additional space for the underlying array.
  *
- * If `sz` is not greater than the current capacity, this macro does nothing.
+ * If `sz` is not greater than the current capacity, the capacity is unchanged.
  *
  * Possible error values:
  * - `DA_SUCCESS`
@@ -317,16 +833,41 @@ do {                                                                          \
 	}                                                                     \
 	/* reserve cannot shrink array */                                     \
 	if ((size_t)(sz) <= (da).capacity) {                                  \
+		DA__SUCCESS(da);                                              \
 		break;                                                        \
 	}                                                                     \
-	(da).data = realloc((da).data, (size_t)(sz) * sizeof((da).data[0]));  \
-	if ((da).data == NULL) {                                              \
-		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
+	da_errno_type da_err = da__reserve(                                   \
+		(void**)&(da).data, &(da).capacity, (size_t)(sz),             \
+		sizeof((da).data[0]), (da).allocator, (da).allocator_ctx      \
+	);                                                                    \
+	if (da_err != DA_SUCCESS) {                                           \
+		DA_SET_ERROR(da, da_err);                                     \
 		break;                                                        \
 	}                                                                     \
-	/* new elements are left un-initialised */                            \
-	(da).capacity = (sz);                                                 \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Grows the array to hold at least `required` elements, following the growth
+ * policy of the array, or the curve given by `DA_FACTOR_NUM`, `DA_FACTOR_DEN`
+ * and `DA_BIAS`.
+ *
+ * On failure the capacity is left unchanged and the errnum is set, on success
+ * the errnum is left to the caller.
+ *
+ * @param         da      	A dynamic array object.
+ * @param         required	The minimum new capacity of the array.
+ */
+#define DA__GROW(da, required)                                                \
+do {                                                                          \
+	da_errno_type da_err = da__grow(                                      \
+		(void**)&(da).data, &(da).capacity, (required),               \
+		sizeof((da).data[0]), (da).allocator, (da).allocator_ctx,     \
+		(da).growth                                                   \
+	);                                                                    \
+	if (da_err != DA_SUCCESS) {                                           \
+		DA_SET_ERROR(da, da_err);                                     \
+	}                                                                     \
 } while (0)
 
 /**
@@ -336,16 +877,102 @@ do {                                                                          \
  */
 #define DA_CAPACITY(da) (da).capacity
 
+/**
+ * Reduces the capacity of the array to its size (or `DA_INITIAL_CAPACITY`,
+ * whichever is greater).
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * NOTE: If the capacity is reduced, all pointers and iterators may be
+ * invalidated.
+ *
+ * @param         da	A dynamic array object.
+ */
+#define DA_SHRINK_TO_FIT(da)                                                  \
+do {                                                                          \
+	size_t da_cap = ((da).size < DA_INITIAL_CAPACITY)                     \
+		? DA_INITIAL_CAPACITY                                         \
+		: (da).size;                                                  \
+	if (da_cap >= (da).capacity) {                                        \
+		DA__SUCCESS(da);                                              \
+		break;                                                        \
+	}                                                                     \
+	void* da_data = DA__REALLOC(                                          \
+		da, (da).data,                                                \
+		(da).capacity * sizeof((da).data[0]),                         \
+		da_cap * sizeof((da).data[0])                                 \
+	);                                                                    \
+	/* on failure the old block is still valid */                         \
+	if (da_data == NULL) {                                                \
+		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
+		break;                                                        \
+	}                                                                     \
+	(da).data = da_data;                                                  \
+	(da).capacity = DA__USABLE_CAPACITY(da, da_data, da_cap);             \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Halves the capacity of the array while its size is below `1 /
+ * DA_AUTO_SHRINK` of it, does nothing unless `DA_AUTO_SHRINK` is defined.
+ *
+ * Failing to shrink is not an error, the array keeps its current block.
+ *
+ * @param         da	A dynamic array object.
+ */
+#ifdef DA_AUTO_SHRINK
+#define DA__AUTO_SHRINK(da)                                                   \
+do {                                                                          \
+	size_t da_cap = (da).capacity;                                        \
+	while (                                                               \
+		(da).size < da_cap / DA_AUTO_SHRINK &&                        \
+		da_cap / 2 >= DA_INITIAL_CAPACITY                             \
+	) {                                                                   \
+		da_cap /= 2;                                                  \
+	}                                                                     \
+	if (da_cap == (da).capacity) {                                        \
+		break;                                                        \
+	}                                                                     \
+	void* da_data = DA__REALLOC(                                          \
+		da, (da).data,                                                \
+		(da).capacity * sizeof((da).data[0]),                         \
+		da_cap * sizeof((da).data[0])                                 \
+	);                                                                    \
+	if (da_data != NULL) {                                                \
+		(da).data = da_data;                                          \
+		(da).capacity = DA__USABLE_CAPACITY(da, da_data, da_cap);     \
+	}                                                                     \
+} while (0)
+#else
+#define DA__AUTO_SHRINK(da) do { } while (0)
+#endif
+
 /** Modifiers ****************************************************************/
 
 /**
  * Clears the array, setting the size to 0, without free'ing memory.
  *
+ * The elements are not zero'd, see `DA_CLEAR_ZERO`.
+ *
  * @param         da  	A dynamic array object.
  */
 #define DA_CLEAR(da)                                                          \
 do {                                                                          \
-	memset((da).data, 0, (da).size * sizeof((da).data[0]));               \
+	(da).size = 0;                                                        \
+} while (0)
+
+/**
+ * As `DA_CLEAR`, but the elements are zero'd first, e.g. to scrub secrets.
+ *
+ * @param         da  	A dynamic array object.
+ */
+#define DA_CLEAR_ZERO(da)                                                     \
+do {                                                                          \
+	if ((da).size > 0) {                                                  \
+		memset((da).data, 0, (da).size * sizeof((da).data[0]));       \
+	}                                                                     \
 	(da).size = 0;                                                        \
 } while (0)
 
@@ -372,60 +999,294 @@ do {                                                                          \
 		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
 		break;                                                        \
 	}                                                                     \
-	if ((da).size >= (da).capacity) {                                     \
-		DA_RESERVE(da, (size_t)((da).capacity * DA_FACTOR) + DA_BIAS);\
+	/* the iterator does not survive a reallocation, the offset does */   \
+	size_t da_offset = (size_t)((it) - DA_BEGIN(da));                     \
+	if (DA__UNLIKELY((da).size >= (da).capacity)) {                       \
+		DA__GROW(da, (da).size + 1);                                  \
 		/* passthrough errnum */                                      \
-		if ((da).errnum != DA_SUCCESS) {                              \
+		if ((da).size >= (da).capacity) {                             \
 			break;                                                \
 		}                                                             \
 	}                                                                     \
-	/* shift elements */                                                  \
-	if ((it) < DA_END(da)) {                                              \
-		void* dst = (it) + 1;                                         \
-		void* src = it;                                               \
-		ptrdiff_t elem_count = ((da).data + (da).capacity - 1) - (it);\
+	/* shift live elements only */                                        \
+	if (da_offset < (da).size) {                                          \
+		void* dst = &(da).data[da_offset + 1];                        \
+		void* src = &(da).data[da_offset];                            \
+		size_t elem_count = (da).size - da_offset;                    \
 		size_t num_bytes = elem_count * sizeof((da).data[0]);         \
 		memmove(dst, src, num_bytes);                                 \
 	}                                                                     \
 	/* insert new element */                                              \
-	(*(it)) = (elem);                                                     \
+	(da).data[da_offset] = (elem);                                        \
 	++(da).size;                                                          \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__SUCCESS(da);                                                      \
 } while (0)
 
 /**
- * Erases the element referenced by the iterator from the array.
+ * Inserts `n` elements, copied from `ptr`, into the array at the point before
+ * the iterator.
+ *
+ * The tail of the array is shifted once for the whole block, and the array
+ * grows at most once.
  *
  * Possible error values:
  * - `DA_SUCCESS`
- * - `DA_INVALID_ITERATOR`
  * - `DA_OUT_OF_BOUNDS`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * NOTE: `ptr` must not point into the array itself.
  *
  * @param         da 	A dynamic array object.
  * @param         it 	An iterator for the given array.
+ * @param         ptr	Pointer to the first element to insert.
+ * @param         n  	The number of elements to insert.
  *
- * @see `da_iter_type`
- * @see	`DA_BEGIN`
- * @see	`DA_END`
+ * @see `DA_INSERT`
  */
-#define DA_ERASE(da, it)                                                      \
+#define DA_INSERT_N(da, it, ptr, n)                                           \
 do {                                                                          \
-	if ((it) < DA_BEGIN(da) || (it) >= DA_END(da)) {                      \
+	if ((it) < DA_BEGIN(da) || (it) > DA_END(da)) {                       \
 		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
 		break;                                                        \
 	}                                                                     \
-	/* shift elements */                                                  \
-	if ((it) < &DA_BACK(da)) {                                            \
+	size_t da_offset = (size_t)((it) - DA_BEGIN(da));                     \
+	size_t da_count = (n);                                                \
+	/* no object exceeds PTRDIFF_MAX bytes, so size + n cannot wrap */    \
+	if (                                                                  \
+		da_count > PTRDIFF_MAX / sizeof((da).data[0]) ||              \
+		(da).size + da_count > PTRDIFF_MAX / sizeof((da).data[0])     \
+	) {                                                                   \
+		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
+		break;                                                        \
+	}                                                                     \
+	if (DA__UNLIKELY((da).size + da_count > (da).capacity)) {             \
+		DA__GROW(da, (da).size + da_count);                           \
+		/* passthrough errnum */                                      \
+		if ((da).size + da_count > (da).capacity) {                   \
+			break;                                                \
+		}                                                             \
+	}                                                                     \
+	/* shift live elements only */                                        \
+	if (da_offset < (da).size) {                                          \
+		void* dst = &(da).data[da_offset + da_count];                 \
+		void* src = &(da).data[da_offset];                            \
+		size_t elem_count = (da).size - da_offset;                    \
+		size_t num_bytes = elem_count * sizeof((da).data[0]);         \
+		memmove(dst, src, num_bytes);                                 \
+	}                                                                     \
+	if (da_count > 0) {                                                   \
+		memcpy(                                                       \
+			&(da).data[da_offset], (ptr),                         \
+			da_count * sizeof((da).data[0])                       \
+		);                                                            \
+	}                                                                     \
+	(da).size += da_count;                                                \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Erases the element referenced by the iterator from the array.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_INVALID_ITERATOR`
+ * - `DA_OUT_OF_BOUNDS`
+ *
+ * NOTE: If `DA_AUTO_SHRINK` is defined the array may be shrunk, invalidating
+ * all pointers and iterators.
+ *
+ * @param         da 	A dynamic array object.
+ * @param         it 	An iterator for the given array.
+ *
+ * @see `da_iter_type`
+ * @see	`DA_BEGIN`
+ * @see	`DA_END`
+ */
+#define DA_ERASE(da, it)                                                      \
+do {                                                                          \
+	if ((it) < DA_BEGIN(da) || (it) >= DA_END(da)) {                      \
+		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
+		break;                                                        \
+	}                                                                     \
+	/* shift live elements only */                                        \
+	if ((it) < &DA_BACK(da)) {                                            \
 		void* dst = it;                                               \
 		void* src = (it) + 1;                                         \
-		size_t elem_count = ((da).data + (da).capacity - 1) - (it);   \
+		size_t elem_count = (size_t)(DA_END(da) - (it)) - 1;          \
 		size_t num_bytes = elem_count * sizeof((da).data[0]);         \
 		memmove(dst, src, num_bytes);                                 \
 	}                                                                     \
-	/* zero memory of last element */                                     \
-	memset(&DA_BACK(da), 0, sizeof((da).data[0]));                        \
 	--(da).size;                                                          \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__AUTO_SHRINK(da);                                                  \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Erases the elements in the range [first, last) from the array.
+ *
+ * The tail of the array is shifted once for the whole range.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_INVALID_ITERATOR`
+ * - `DA_OUT_OF_BOUNDS`
+ *
+ * NOTE: If `DA_AUTO_SHRINK` is defined the array may be shrunk, invalidating
+ * all pointers and iterators.
+ *
+ * @param         da   	A dynamic array object.
+ * @param         first	An iterator to the first element to erase.
+ * @param         last 	An iterator one past the last element to erase.
+ *
+ * @see `DA_ERASE`
+ */
+#define DA_ERASE_RANGE(da, first, last)                                       \
+do {                                                                          \
+	if ((first) < DA_BEGIN(da) || (last) > DA_END(da)) {                  \
+		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
+		break;                                                        \
+	}                                                                     \
+	if ((first) > (last)) {                                               \
+		DA_SET_ERROR(da, DA_INVALID_ITERATOR);                        \
+		break;                                                        \
+	}                                                                     \
+	size_t da_first = (size_t)((first) - DA_BEGIN(da));                   \
+	size_t da_last = (size_t)((last) - DA_BEGIN(da));                     \
+	/* shift live elements only */                                        \
+	if (da_last < (da).size) {                                            \
+		void* dst = &(da).data[da_first];                             \
+		void* src = &(da).data[da_last];                              \
+		size_t elem_count = (da).size - da_last;                      \
+		size_t num_bytes = elem_count * sizeof((da).data[0]);         \
+		memmove(dst, src, num_bytes);                                 \
+	}                                                                     \
+	(da).size -= da_last - da_first;                                      \
+	DA__AUTO_SHRINK(da);                                                  \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Erases the elements at the given indices, which must be sorted in ascending
+ * order (duplicates are erased once).
+ *
+ * The remaining elements are compacted in a single pass, each run of elements
+ * between two erased indices is moved with one `memmove`. The indices are
+ * checked before the array is modified.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_INVALID_ITERATOR` (the indices are not sorted)
+ * - `DA_OUT_OF_BOUNDS`
+ *
+ * NOTE: If `DA_AUTO_SHRINK` is defined the array may be shrunk, invalidating
+ * all pointers and iterators.
+ *
+ * @param         da     	A dynamic array object.
+ * @param         indices	Pointer to the first of the sorted indices.
+ * @param         count  	The number of indices.
+ *
+ * @see `DA_ERASE_RANGE`
+ */
+#define DA_ERASE_INDICES(da, indices, count)                                  \
+do {                                                                          \
+	size_t da_count = (count);                                            \
+	size_t da_k = 0;                                                      \
+	for (; da_k + 1 < da_count; ++da_k) {                                 \
+		if ((size_t)(indices)[da_k] > (size_t)(indices)[da_k + 1]) {  \
+			break;                                                \
+		}                                                             \
+	}                                                                     \
+	if (da_k + 1 < da_count) {                                            \
+		DA_SET_ERROR(da, DA_INVALID_ITERATOR);                        \
+		break;                                                        \
+	}                                                                     \
+	if (da_count > 0 && (size_t)(indices)[da_count - 1] >= (da).size) {   \
+		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
+		break;                                                        \
+	}                                                                     \
+	size_t da_dst = (da_count > 0) ? (size_t)(indices)[0] : (da).size;    \
+	for (da_k = 0; da_k < da_count; ++da_k) {                             \
+		size_t da_from = (size_t)(indices)[da_k] + 1;                 \
+		size_t da_to = (da_k + 1 < da_count)                          \
+			? (size_t)(indices)[da_k + 1]                         \
+			: (da).size;                                          \
+		if (da_to <= da_from) {                                       \
+			continue;                                             \
+		}                                                             \
+		memmove(                                                      \
+			&(da).data[da_dst], &(da).data[da_from],              \
+			(da_to - da_from) * sizeof((da).data[0])              \
+		);                                                            \
+		da_dst += da_to - da_from;                                    \
+	}                                                                     \
+	(da).size = da_dst;                                                   \
+	DA__AUTO_SHRINK(da);                                                  \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Erases the element referenced by the iterator by moving the last element
+ * into its place, in constant time. The order of the elements is not kept.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_OUT_OF_BOUNDS`
+ *
+ * NOTE: If `DA_AUTO_SHRINK` is defined the array may be shrunk, invalidating
+ * all pointers and iterators.
+ *
+ * @param         da	A dynamic array object.
+ * @param         it	An iterator for the given array.
+ *
+ * @see `DA_ERASE`
+ */
+#define DA_SWAP_REMOVE(da, it)                                                \
+do {                                                                          \
+	if ((it) < DA_BEGIN(da) || (it) >= DA_END(da)) {                      \
+		DA_SET_ERROR(da, DA_OUT_OF_BOUNDS);                           \
+		break;                                                        \
+	}                                                                     \
+	*(it) = DA_BACK(da);                                                  \
+	--(da).size;                                                          \
+	DA__AUTO_SHRINK(da);                                                  \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Erases every element for which `cond` is true, in a single pass that keeps
+ * the order of the remaining elements.
+ *
+ * `it` is the name of an iterator, declared by the macro, that points at the
+ * element being tested, e.g. `DA_ERASE_IF(da, it, *it < 0);`.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ *
+ * NOTE: If `DA_AUTO_SHRINK` is defined the array may be shrunk, invalidating
+ * all pointers and iterators.
+ *
+ * @param         da  	A dynamic array object.
+ * @param         it  	The name of the iterator used by `cond`.
+ * @param         cond	An expression, true for the elements to erase.
+ *
+ * @see `DA_ERASE`
+ */
+#define DA_ERASE_IF(da, it, cond)                                             \
+do {                                                                          \
+	size_t da_kept = 0;                                                   \
+	for (size_t da_i = 0; da_i < (da).size; ++da_i) {                     \
+		da_iter_type(da) it = &(da).data[da_i];                       \
+		if (cond) {                                                   \
+			continue;                                             \
+		}                                                             \
+		if (da_kept != da_i) {                                        \
+			(da).data[da_kept] = *it;                             \
+		}                                                             \
+		++da_kept;                                                    \
+	}                                                                     \
+	(da).size = da_kept;                                                  \
+	DA__AUTO_SHRINK(da);                                                  \
+	DA__SUCCESS(da);                                                      \
 } while (0)
 
 /**
@@ -444,16 +1305,131 @@ do {                                                                          \
  */
 #define DA_PUSH_BACK(da, elem)                                                \
 do {                                                                          \
-	if ((da).size == (da).capacity) {                                     \
-		DA_RESERVE(da, (size_t)((da).capacity * DA_FACTOR) + DA_BIAS);\
+	if (DA__UNLIKELY((da).size == (da).capacity)) {                       \
+		DA__GROW(da, (da).size + 1);                                  \
 		/* passthrough errnum */                                      \
-		if ((da).errnum != DA_SUCCESS) {                              \
+		if ((da).size == (da).capacity) {                             \
 			break;                                                \
 		}                                                             \
 	}                                                                     \
 	(da).data[(da).size] = (elem);                                        \
 	++(da).size;                                                          \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Appends `n` elements, copied from `ptr`, to the end of the array.
+ *
+ * The array grows at most once and the elements are copied with a single
+ * `memcpy`.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * NOTE: If a resize occurs, all pointers will be invalidated, `ptr` is only
+ * evaluated after the resize.
+ *
+ * @param         da 	A dynamic array object.
+ * @param         ptr	Pointer to the first element to append.
+ * @param         n  	The number of elements to append.
+ *
+ * @see	`DA_INSERT_N`
+ */
+#define DA_APPEND_N(da, ptr, n)                                               \
+do {                                                                          \
+	size_t da_count = (n);                                                \
+	/* no object exceeds PTRDIFF_MAX bytes, so size + n cannot wrap */    \
+	if (                                                                  \
+		da_count > PTRDIFF_MAX / sizeof((da).data[0]) ||              \
+		(da).size + da_count > PTRDIFF_MAX / sizeof((da).data[0])     \
+	) {                                                                   \
+		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
+		break;                                                        \
+	}                                                                     \
+	if (DA__UNLIKELY((da).size + da_count > (da).capacity)) {             \
+		DA__GROW(da, (da).size + da_count);                           \
+		/* passthrough errnum */                                      \
+		if ((da).size + da_count > (da).capacity) {                   \
+			break;                                                \
+		}                                                             \
+	}                                                                     \
+	if (da_count > 0) {                                                   \
+		memcpy(                                                       \
+			&(da).data[(da).size], (ptr),                         \
+			da_count * sizeof((da).data[0])                       \
+		);                                                            \
+	}                                                                     \
+	(da).size += da_count;                                                \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Appends every element of another dynamic array (of the same type) to the
+ * end of the array.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * @param         da   	A dynamic array object.
+ * @param         other	The dynamic array to copy from, may be `da`
+ *                    	itself.
+ *
+ * @see	`DA_APPEND_N`
+ */
+#define DA_APPEND_ARRAY(da, other)                                            \
+	DA_APPEND_N(da, DA_DATA(other), DA_SIZE(other))
+
+/**
+ * Appends a new, un-initialised, element to the dynamic array, resizing if
+ * necessary, and points `slot` at it so that it can be constructed in place.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * NOTE: On failure `slot` is set to `NULL`. The slot is only valid until the
+ * array is next modified.
+ *
+ * @param         da  	A dynamic array object.
+ * @param         slot	A `value_type*` lvalue, set to the new element.
+ *
+ * @see	`DA_PUSH_BACK`
+ */
+#define DA_PUSH_BACK_SLOT(da, slot)                                           \
+do {                                                                          \
+	(slot) = NULL;                                                        \
+	if (DA__UNLIKELY((da).size == (da).capacity)) {                       \
+		DA__GROW(da, (da).size + 1);                                  \
+		/* passthrough errnum */                                      \
+		if ((da).size == (da).capacity) {                             \
+			break;                                                \
+		}                                                             \
+	}                                                                     \
+	(slot) = &(da).data[(da).size];                                       \
+	++(da).size;                                                          \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/**
+ * Appends a new element to the dynamic array without checking the capacity.
+ *
+ * The caller guarantees that `DA_SIZE` is less than `DA_CAPACITY`, e.g. by
+ * calling `DA_RESERVE` beforehand, the array is never reallocated and the
+ * errnum is not modified.
+ *
+ * @param         da  	A dynamic array object.
+ * @param         elem	The object to insert into the array.
+ *
+ * @see `DA_ASSERT`
+ * @see	`DA_RESERVE`
+ */
+#define DA_PUSH_BACK_UNCHECKED(da, elem)                                      \
+do {                                                                          \
+	DA_ASSERT((da).size < (da).capacity);                                 \
+	(da).data[(da).size] = (elem);                                        \
+	++(da).size;                                                          \
 } while (0)
 
 /**
@@ -472,32 +1448,362 @@ do {                                                                          \
  * @param         sz	The new size of the array.
  */
 #define DA_RESIZE(da, sz)                                                     \
+do {                                                                          \
+	size_t da_old_size = (da).size;                                       \
+	/* `sz` may depend on the size, e.g. `DA_SIZE(da) + 4` */             \
+	size_t da_new_size = (sz);                                            \
+	DA_RESIZE_UNINIT(da, da_new_size);                                    \
+	/* new elements are zero'd */                                         \
+	if ((da).size == da_new_size && (da).size > da_old_size) {            \
+		memset(                                                       \
+			&(da).data[da_old_size], 0,                           \
+			((da).size - da_old_size) * sizeof((da).data[0])      \
+		);                                                            \
+	}                                                                     \
+} while (0)
+
+/**
+ * As `DA_RESIZE`, but new elements are left un-initialised.
+ *
+ * For arrays that are about to be overwritten as a whole, e.g. by `read`.
+ *
+ * Possible error values:
+ * - `DA_SUCCESS`
+ * - `DA_INVALID_SIZE`
+ * - `DA_OUT_OF_MEMORY`
+ *
+ * @param         da	A dynamic array object.
+ * @param         sz	The new size of the array.
+ */
+#define DA_RESIZE_UNINIT(da, sz)                                              \
 do {                                                                          \
 	if ((sz) == 0) {                                                      \
 		DA_SET_ERROR(da, DA_INVALID_SIZE);                            \
 		break;                                                        \
 	}                                                                     \
 	if ((size_t)(sz) == (da).size) {                                      \
-		DA_SET_ERROR(da, DA_SUCCESS);                                 \
+		DA__SUCCESS(da);                                              \
 		break;                                                        \
 	}                                                                     \
 	/* only reallocate if required */                                     \
 	if ((size_t)(sz) != (da).capacity) {                                  \
-		(da).data = realloc((da).data, (sz) * sizeof((da).data[0]));  \
-	}                                                                     \
-	if ((da).data == NULL) {                                              \
-		DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                           \
-		break;                                                        \
-	}                                                                     \
-	/* new memory is zero'd */                                            \
-	if ((size_t)(sz) > (da).capacity) {                                   \
-		size_t num_elements = ((sz) - (da).capacity);                 \
-		size_t byte_count  = num_elements * sizeof((da).data[0]);     \
-		memset(&(da).data[(da).capacity], 0, byte_count);             \
+		if ((size_t)(sz) > SIZE_MAX / sizeof((da).data[0])) {         \
+			DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                   \
+			break;                                                \
+		}                                                             \
+		void* da_data = DA__REALLOC(                                  \
+			da, (da).data,                                        \
+			(da).capacity * sizeof((da).data[0]),                 \
+			(size_t)(sz) * sizeof((da).data[0])                   \
+		);                                                            \
+		/* on failure the old block is still valid */                 \
+		if (da_data == NULL) {                                        \
+			DA_SET_ERROR(da, DA_OUT_OF_MEMORY);                   \
+			break;                                                \
+		}                                                             \
+		(da).data = da_data;                                          \
+		(da).capacity = DA__USABLE_CAPACITY(da, da_data, sz);         \
 	}                                                                     \
-	(da).capacity = (sz);                                                 \
 	(da).size = (sz);                                                     \
-	DA_CLEAR_ERROR(da);                                                   \
+	DA__SUCCESS(da);                                                      \
+} while (0)
+
+/** Small Arrays *************************************************************/
+
+/**
+ * A dynamic array with inline storage for its first `n` elements, these
+ * members should not be modified directly.
+ *
+ * Every macro that accepts a `da_type` also accepts a `da_small_type`. The
+ * array only allocates once it grows beyond `n` elements, the elements are
+ * then moved to the heap (and stay there).
+ *
+ * NOTE: while the elements are inline the data pointer points into the object
+ * itself, so the object must not be copied or moved (e.g. by assignment or
+ * `memcpy`) after it has been created.
+ *
+ * @param         value_type	the type of the array element
+ * @param         n         	the number of inline elements
+ */
+#define da_small_type(value_type, n)                                          \
+struct {                                                                      \
+	DA__MEMBERS(value_type)                                               \
+	/* the start and end of `small`, the allocator context */             \
+	void* small_bounds[2];                                                \
+	value_type small[n];                                                  \
+}
+
+/**
+ * `da_allocator_type::reallocate` for small arrays, `ctx` points to the start
+ * and the end of the inline storage of the array.
+ *
+ * The inline storage is kept for any size that fits in it, even after the
+ * capacity was reduced. It is never handed to the default allocator, growing
+ * out of it allocates a new block and copies the elements.
+ */
+static inline void* da__small_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	void** bounds = ctx;
+	if (ptr != bounds[0]) {
+		return DA_REALLOC(ptr, new_size);
+	}
+	if (new_size <= (size_t)((char*)bounds[1] - (char*)bounds[0])) {
+		return ptr;
+	}
+	void* block = DA_MALLOC(new_size);
+	if (block != NULL) {
+		memcpy(block, ptr, old_size);
+	}
+	return block;
+}
+
+/**
+ * `da_allocator_type::deallocate` for small arrays, the inline storage is not
+ * free'd.
+ */
+static inline void da__small_deallocate(void* ctx, void* ptr, size_t size) {
+	(void)size;
+
+	if (ptr != ((void**)ctx)[0]) {
+		DA_FREE(ptr);
+	}
+}
+
+/**
+ * The allocator used by small arrays.
+ */
+static const da_allocator_type da_small_allocator = {
+	da__small_reallocate, da__small_deallocate
+};
+
+/**
+ * Initialises a small array to use its inline storage, nothing is allocated.
+ *
+ * @param         da	A small dynamic array object.
+ *
+ * @see	`da_small_type`
+ * @see	`DA_DESTROY`
+ */
+#define DA_SMALL_CREATE(da)                                                   \
+do {                                                                          \
+	size_t da_count = sizeof((da).small) / sizeof((da).small[0]);         \
+	(da).small_bounds[0] = (da).small;                                    \
+	(da).small_bounds[1] = (da).small + da_count;                         \
+	(da).allocator = &da_small_allocator;                                 \
+	(da).allocator_ctx = (da).small_bounds;                               \
+	(da).growth = NULL;                                                   \
+	(da).data = (da).small;                                               \
+	(da).size = 0;                                                        \
+	(da).capacity = da_count;                                             \
+	(da).errnum = DA_SUCCESS;                                             \
+	(da).file = NULL;                                                     \
+	(da).line = 0;                                                        \
+} while (0)
+
+/** Static Arrays ************************************************************/
+
+/**
+ * A dynamic array with a fixed capacity of `n` elements, stored inside the
+ * object, these members should not be modified directly.
+ *
+ * Every macro that accepts a `da_type` also accepts a `da_static_type`. The
+ * array never allocates, growing beyond `n` elements sets the errnum to
+ * `DA_OUT_OF_MEMORY` and leaves the array unchanged.
+ *
+ * NOTE: the data pointer points into the object itself, so the object must not
+ * be copied or moved (e.g. by assignment or `memcpy`) after it has been
+ * created.
+ *
+ * @param         value_type	the type of the array element
+ * @param         n         	the capacity of the array
+ */
+#define da_static_type(value_type, n)                                         \
+struct {                                                                      \
+	DA__MEMBERS(value_type)                                               \
+	value_type storage[n];                                                \
+}
+
+/**
+ * `da_allocator_type::reallocate` for static arrays, `ctx` points one past the
+ * end of the storage of the array.
+ *
+ * Succeeds (without moving) for any size that fits in the storage.
+ */
+static inline void* da__static_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	(void)old_size;
+
+	if (ptr == NULL) {
+		return NULL;
+	}
+	if (new_size > (size_t)((unsigned char*)ctx - (unsigned char*)ptr)) {
+		return NULL;
+	}
+	return ptr;
+}
+
+/**
+ * `da_allocator_type::deallocate` for static arrays, does nothing.
+ */
+static inline void da__static_deallocate(void* ctx, void* ptr, size_t size) {
+	(void)ctx;
+	(void)ptr;
+	(void)size;
+}
+
+/**
+ * The allocator used by static arrays.
+ */
+static const da_allocator_type da_static_allocator = {
+	da__static_reallocate, da__static_deallocate
+};
+
+/**
+ * Initialises a static array, nothing is allocated.
+ *
+ * `DA_DESTROY` "zero"s the array, it can then be re-initialised with
+ * `DA_STATIC_CREATE`.
+ *
+ * @param         da	A static dynamic array object.
+ *
+ * @see	`da_static_type`
+ */
+#define DA_STATIC_CREATE(da)                                                  \
+do {                                                                          \
+	size_t da_count = sizeof((da).storage) / sizeof((da).storage[0]);     \
+	(da).allocator = &da_static_allocator;                                \
+	(da).allocator_ctx = (da).storage + da_count;                         \
+	(da).growth = NULL;                                                   \
+	(da).data = (da).storage;                                             \
+	(da).size = 0;                                                        \
+	(da).capacity = da_count;                                             \
+	(da).errnum = DA_SUCCESS;                                             \
+	(da).file = NULL;                                                     \
+	(da).line = 0;                                                        \
 } while (0)
 
+/** Typed Functions **********************************************************/
+
+/**
+ * Defines a dynamic array type, `name`, and a set of functions for it, as an
+ * alternative to the macros (which remain available for the type).
+ *
+ * The fast paths are `static inline`, growth and other reallocations are
+ * `static` and out of line (`DA__COLD`), so each call site costs a call rather
+ * than a copy of the whole reallocation path. The functions that can fail
+ * return the result of the operation, which is also recorded as the errnum of
+ * the array.
+ *
+ * - `void name_create(name*)`
+ * - `void name_destroy(name*)`
+ * - `da_errno_type name_reserve(name*, size_t)`
+ * - `da_errno_type name_resize(name*, size_t)`
+ * - `T* name_at(name*, size_t)`, `NULL` if out of bounds
+ * - `da_errno_type name_push_back(name*, T)`
+ * - `da_errno_type name_insert(name*, size_t, T)`
+ * - `da_errno_type name_erase(name*, size_t)`
+ * - `void name_clear(name*)`
+ *
+ * Used at file scope, followed by a semicolon, e.g. `DA_DEFINE(ints, int);`.
+ *
+ * @param         name      	the name of the array type, and the function
+ *                          	prefix
+ * @param         value_type	the type of the array element
+ */
+#define DA_DEFINE(name, value_type)                                           \
+typedef da_type(value_type) name;                                             \
+                                                                              \
+static inline void name##_create(name* da) {                                  \
+	DA_CREATE(*da);                                                       \
+}                                                                             \
+                                                                              \
+static inline void name##_destroy(name* da) {                                 \
+	DA_DESTROY(*da);                                                      \
+}                                                                             \
+                                                                              \
+static DA__COLD void name##__grow(name* da, size_t required) {                \
+	DA__GROW(*da, required);                                              \
+}                                                                             \
+                                                                              \
+static DA__COLD da_errno_type name##_reserve(name* da, size_t n) {            \
+	DA_RESERVE(*da, n);                                                   \
+	if (n == 0) {                                                         \
+		return DA_INVALID_SIZE;                                       \
+	}                                                                     \
+	return (da->capacity >= n) ? DA_SUCCESS : DA_OUT_OF_MEMORY;           \
+}                                                                             \
+                                                                              \
+static DA__COLD da_errno_type name##_resize(name* da, size_t n) {             \
+	DA_RESIZE(*da, n);                                                    \
+	if (n == 0) {                                                         \
+		return DA_INVALID_SIZE;                                       \
+	}                                                                     \
+	return (da->size == n) ? DA_SUCCESS : DA_OUT_OF_MEMORY;               \
+}                                                                             \
+                                                                              \
+static inline value_type* name##_at(name* da, size_t idx) {                   \
+	if (DA__UNLIKELY(idx >= da->size)) {                                  \
+		DA_SET_ERROR(*da, DA_OUT_OF_BOUNDS);                          \
+		return NULL;                                                  \
+	}                                                                     \
+	DA__SUCCESS(*da);                                                     \
+	return &da->data[idx];                                                \
+}                                                                             \
+                                                                              \
+static inline da_errno_type name##_push_back(name* da, value_type elem) {     \
+	if (DA__UNLIKELY(da->size == da->capacity)) {                         \
+		name##__grow(da, da->size + 1);                               \
+		if (da->size == da->capacity) {                               \
+			return DA_OUT_OF_MEMORY;                              \
+		}                                                             \
+	}                                                                     \
+	da->data[da->size] = elem;                                            \
+	++da->size;                                                           \
+	DA__SUCCESS(*da);                                                     \
+	return DA_SUCCESS;                                                    \
+}                                                                             \
+                                                                              \
+static inline da_errno_type name##_insert(                                    \
+	name* da, size_t idx, value_type elem                                 \
+) {                                                                           \
+	if (DA__UNLIKELY(idx > da->size)) {                                   \
+		DA_SET_ERROR(*da, DA_OUT_OF_BOUNDS);                          \
+		return DA_OUT_OF_BOUNDS;                                      \
+	}                                                                     \
+	if (DA__UNLIKELY(da->size == da->capacity)) {                         \
+		name##__grow(da, da->size + 1);                               \
+		if (da->size == da->capacity) {                               \
+			return DA_OUT_OF_MEMORY;                              \
+		}                                                             \
+	}                                                                     \
+	if (idx < da->size) {                                                 \
+		memmove(                                                      \
+			&da->data[idx + 1], &da->data[idx],                   \
+			(da->size - idx) * sizeof(da->data[0])                \
+		);                                                            \
+	}                                                                     \
+	da->data[idx] = elem;                                                 \
+	++da->size;                                                           \
+	DA__SUCCESS(*da);                                                     \
+	return DA_SUCCESS;                                                    \
+}                                                                             \
+                                                                              \
+static inline da_errno_type name##_erase(name* da, size_t idx) {              \
+	if (DA__UNLIKELY(idx >= da->size)) {                                  \
+		DA_SET_ERROR(*da, DA_OUT_OF_BOUNDS);                          \
+		return DA_OUT_OF_BOUNDS;                                      \
+	}                                                                     \
+	DA_ERASE(*da, &da->data[idx]);                                        \
+	return DA_SUCCESS;                                                    \
+}                                                                             \
+                                                                              \
+static inline void name##_clear(name* da) {                                   \
+	DA_CLEAR(*da);                                                        \
+}                                                                             \
+                                                                              \
+/* declares nothing, so that the macro is followed by a semicolon */          \
+struct name##__define
+
 #endif /* UTILITY_DA_H_ */
@@ -0,0 +1,233 @@
+#ifndef UTILITY_DA32_H_
+#define UTILITY_DA32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "da.h"
+
+/** Compact Arrays ***********************************************************/
+
+/**
+ * A compact dynamic array object with 32-bit size and capacity, these members
+ * should not be modified directly.
+ *
+ * The object is 16 bytes (on 64-bit targets), with no error fields and no
+ * allocator: the modifiers below evaluate to a `da_errno_type`, and the
+ * default allocator is always used.
+ *
+ * The element access, iterator and capacity macros of `da_type` that do not
+ * report errors (`DA_DATA`, `DA_FRONT`, `DA_BACK`, `DA_BEGIN`, `DA_END`,
+ * `DA_EMPTY`, `DA_SIZE`, `DA_CAPACITY` and the `*_UNCHECKED` macros) also
+ * accept a `da_type32`.
+ *
+ * @param         value_type	the type of the array element
+ */
+#define da_type32(value_type)                                                 \
+struct {                                                                      \
+	value_type* data;                                                     \
+	uint32_t size;                                                        \
+	uint32_t capacity;                                                    \
+}
+
+/**
+ * Sets the capacity of a compact array to at least `n` elements.
+ *
+ * @param         data     	pointer to the data pointer of the array
+ * @param         capacity 	pointer to the capacity of the array
+ * @param         n        	the new capacity
+ * @param         elem_size	size of an element, in bytes
+ *
+ * @return	`DA_INVALID_SIZE` if `n` does not fit in 32 bits
+ */
+static inline da_errno_type da__32_reserve(
+	void** data, uint32_t* capacity, size_t n, size_t elem_size
+) {
+	if (n > UINT32_MAX) {
+		return DA_INVALID_SIZE;
+	}
+	if (n <= *capacity) {
+		return DA_SUCCESS;
+	}
+	if (n > SIZE_MAX / elem_size) {
+		return DA_OUT_OF_MEMORY;
+	}
+	void* block = DA_REALLOC(*data, n * elem_size);
+	if (block == NULL) {
+		return DA_OUT_OF_MEMORY;
+	}
+	*data = block;
+	*capacity = (uint32_t)n;
+	return DA_SUCCESS;
+}
+
+/**
+ * Grows a compact array to hold at least `required` elements, following the
+ * growth curve of `da__next_capacity`, but never beyond 32 bits.
+ *
+ * @param         data     	pointer to the data pointer of the array
+ * @param         capacity 	pointer to the capacity of the array
+ * @param         required 	the minimum new capacity
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__32_grow(
+	void** data, uint32_t* capacity, size_t required, size_t elem_size
+) {
+	size_t n = da__next_capacity(*capacity);
+
+	if (n < DA_INITIAL_CAPACITY) {
+		n = DA_INITIAL_CAPACITY;
+	}
+	if (n > UINT32_MAX) {
+		n = UINT32_MAX;
+	}
+	if (n < required) {
+		n = required;
+	}
+	return da__32_reserve(data, capacity, n, elem_size);
+}
+
+/**
+ * Resizes a compact array, new elements are zero'd.
+ *
+ * @param         data     	pointer to the data pointer of the array
+ * @param         size     	pointer to the size of the array
+ * @param         capacity 	pointer to the capacity of the array
+ * @param         n        	the new size
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__32_resize(
+	void** data, uint32_t* size, uint32_t* capacity, size_t n,
+	size_t elem_size
+) {
+	da_errno_type err = da__32_reserve(data, capacity, n, elem_size);
+	if (err != DA_SUCCESS) {
+		return err;
+	}
+	if (n > *size) {
+		unsigned char* end = *data;
+		end += *size * elem_size;
+		memset(end, 0, (n - *size) * elem_size);
+	}
+	*size = (uint32_t)n;
+	return DA_SUCCESS;
+}
+
+/**
+ * Initialises a compact array, nothing is allocated.
+ *
+ * A zero-initialised `da_type32` is also a valid, empty, array.
+ *
+ * @param         da	A compact dynamic array object.
+ */
+#define DA32_CREATE(da)                                                       \
+do {                                                                          \
+	(da).data = NULL;                                                     \
+	(da).size = 0;                                                        \
+	(da).capacity = 0;                                                    \
+} while (0)
+
+/**
+ * Frees the memory of a compact array and "zero"s the object.
+ *
+ * @param         da	A compact dynamic array object.
+ */
+#define DA32_DESTROY(da)                                                      \
+do {                                                                          \
+	DA_FREE((da).data);                                                   \
+	DA32_CREATE(da);                                                      \
+} while (0)
+
+/**
+ * Reserves space for at least `n` elements.
+ *
+ * Evaluates to `DA_SUCCESS`, `DA_INVALID_SIZE` (`n` does not fit in 32 bits)
+ * or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da	A compact dynamic array object.
+ * @param         n 	The new capacity of the array.
+ */
+#define DA32_RESERVE(da, n)                                                   \
+	da__32_reserve(                                                       \
+		(void**)&(da).data, &(da).capacity, (n),                      \
+		sizeof((da).data[0])                                          \
+	)
+
+/**
+ * Resizes the array, new elements are zero'd.
+ *
+ * Evaluates to `DA_SUCCESS`, `DA_INVALID_SIZE` (`n` does not fit in 32 bits)
+ * or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da	A compact dynamic array object.
+ * @param         n 	The new size of the array.
+ */
+#define DA32_RESIZE(da, n)                                                    \
+	da__32_resize(                                                        \
+		(void**)&(da).data, &(da).size, &(da).capacity, (n),          \
+		sizeof((da).data[0])                                          \
+	)
+
+/**
+ * Appends a new element to the array, resizing if necessary.
+ *
+ * Evaluates to `DA_SUCCESS`, `DA_INVALID_SIZE` (the array already holds
+ * `UINT32_MAX` elements) or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da  	A compact dynamic array object.
+ * @param         elem	The object to append to the array.
+ */
+#define DA32_PUSH_BACK(da, elem)                                              \
+	(                                                                     \
+		((da).size < (da).capacity) ? (                               \
+			((da).data[(da).size] = (elem)),                      \
+			++(da).size,                                          \
+			DA_SUCCESS                                            \
+		) : (                                                         \
+			da__32_grow(                                          \
+				(void**)&(da).data, &(da).capacity,           \
+				(size_t)(da).size + 1, sizeof((da).data[0])   \
+			) != DA_SUCCESS                                       \
+		) ? (                                                         \
+			((da).size == UINT32_MAX)                             \
+			? DA_INVALID_SIZE                                     \
+			: DA_OUT_OF_MEMORY                                    \
+		) : (                                                         \
+			((da).data[(da).size] = (elem)),                      \
+			++(da).size,                                          \
+			DA_SUCCESS                                            \
+		)                                                             \
+	)
+
+/**
+ * Erases the element referenced by the iterator from the array.
+ *
+ * Evaluates to `DA_SUCCESS` or `DA_OUT_OF_BOUNDS`.
+ *
+ * @param         da	A compact dynamic array object.
+ * @param         it	An iterator for the given array.
+ */
+#define DA32_ERASE(da, it)                                                    \
+	(                                                                     \
+		((it) < DA_BEGIN(da) || (it) >= DA_END(da)) ? (               \
+			DA_OUT_OF_BOUNDS                                      \
+		) : (                                                         \
+			memmove(                                              \
+				(it), (it) + 1,                               \
+				(size_t)(DA_END(da) - (it) - 1) *             \
+				sizeof((da).data[0])                          \
+			),                                                    \
+			--(da).size,                                          \
+			DA_SUCCESS                                            \
+		)                                                             \
+	)
+
+/**
+ * Clears the array, setting the size to 0, without free'ing memory.
+ *
+ * @param         da	A compact dynamic array object.
+ */
+#define DA32_CLEAR(da) ((void)((da).size = 0))
+
+#endif /* UTILITY_DA32_H_ */
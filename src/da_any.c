@@ -0,0 +1,182 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "da.h"
+#include "da_any.h"
+
+/**
+ * Copies a single element, with fixed size copies for the common sizes so
+ * that they compile to plain loads and stores.
+ *
+ * @param         dst      	the destination element
+ * @param         src      	the source element
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline void da__any_copy(void* dst, const void* src, size_t elem_size) {
+	switch (elem_size) {
+	case 1:
+		memcpy(dst, src, 1);
+		break;
+	case 2:
+		memcpy(dst, src, 2);
+		break;
+	case 4:
+		memcpy(dst, src, 4);
+		break;
+	case 8:
+		memcpy(dst, src, 8);
+		break;
+	case 16:
+		memcpy(dst, src, 16);
+		break;
+	default:
+		memcpy(dst, src, elem_size);
+		break;
+	}
+}
+
+/**
+ * Byte offset of `elem` into the array, so that an element of the array can
+ * be found again once the array has grown or been shifted.
+ *
+ * @param         da  	A type-erased dynamic array object.
+ * @param         elem	Pointer to an element, maybe in the array.
+ *
+ * @return	the offset, or `SIZE_MAX` if `elem` is not in the array
+ */
+static size_t da__any_offset(const da_any_type* da, const void* elem) {
+	uintptr_t begin = (uintptr_t)da->data;
+	uintptr_t p = (uintptr_t)elem;
+	if (p < begin || p - begin >= da->size * da->elem_size) {
+		return SIZE_MAX;
+	}
+	return p - begin;
+}
+
+/**
+ * Grows the array to hold at least `required` elements.
+ *
+ * @param         da      	A type-erased dynamic array object.
+ * @param         required	The minimum new capacity of the array.
+ */
+static DA__COLD da_errno_type da__any_grow(da_any_type* da, size_t required) {
+	if (da->elem_size == 0) {
+		return DA_INVALID_SIZE;
+	}
+	return da__grow(
+		&da->data, &da->capacity, required, da->elem_size,
+		da->allocator, da->allocator_ctx, da->growth
+	);
+}
+
+void da_any_create(da_any_type* da, size_t elem_size) {
+	da_any_create_with(da, elem_size, NULL, NULL);
+}
+
+void da_any_create_with(
+	da_any_type* da, size_t elem_size, const da_allocator_type* alloc,
+	void* ctx
+) {
+	da->data = NULL;
+	da->size = 0;
+	da->capacity = 0;
+	da->allocator = alloc;
+	da->allocator_ctx = ctx;
+	da->growth = NULL;
+	da->elem_size = elem_size;
+}
+
+void da_any_destroy(da_any_type* da) {
+	if (da->data != NULL) {
+		DA__FREE(*da, da->data, da->capacity * da->elem_size);
+	}
+	da->data = NULL;
+	da->size = 0;
+	da->capacity = 0;
+	da->allocator = NULL;
+	da->allocator_ctx = NULL;
+	da->growth = NULL;
+}
+
+da_errno_type da_any_reserve(da_any_type* da, size_t n) {
+	if (n == 0 || da->elem_size == 0) {
+		return DA_INVALID_SIZE;
+	}
+	/* reserve cannot shrink array */
+	if (n <= da->capacity) {
+		return DA_SUCCESS;
+	}
+	return da__reserve(
+		&da->data, &da->capacity, n, da->elem_size,
+		da->allocator, da->allocator_ctx
+	);
+}
+
+void* da_any_get(const da_any_type* da, size_t idx) {
+	if (DA__UNLIKELY(idx >= da->size)) {
+		return NULL;
+	}
+	return (unsigned char*)da->data + idx * da->elem_size;
+}
+
+da_errno_type da_any_push_back(da_any_type* da, const void* elem) {
+	if (DA__UNLIKELY(da->size == da->capacity)) {
+		/* growing frees the old block, which `elem` may point into */
+		size_t offset = da__any_offset(da, elem);
+		da_errno_type err = da__any_grow(da, da->size + 1);
+		if (err != DA_SUCCESS) {
+			return err;
+		}
+		if (offset != SIZE_MAX) {
+			elem = (unsigned char*)da->data + offset;
+		}
+	}
+	unsigned char* end = da->data;
+	end += da->size * da->elem_size;
+	da__any_copy(end, elem, da->elem_size);
+	++da->size;
+	return DA_SUCCESS;
+}
+
+da_errno_type da_any_insert(da_any_type* da, size_t idx, const void* elem) {
+	if (DA__UNLIKELY(idx > da->size)) {
+		return DA_OUT_OF_BOUNDS;
+	}
+	/* `elem` may point into the array, which can move or shift under it */
+	size_t offset = da__any_offset(da, elem);
+	if (DA__UNLIKELY(da->size == da->capacity)) {
+		da_errno_type err = da__any_grow(da, da->size + 1);
+		if (err != DA_SUCCESS) {
+			return err;
+		}
+	}
+	unsigned char* it = (unsigned char*)da->data + idx * da->elem_size;
+	/* shift live elements only */
+	if (idx < da->size) {
+		memmove(
+			it + da->elem_size, it, (da->size - idx) * da->elem_size
+		);
+	}
+	if (offset != SIZE_MAX) {
+		if (offset >= idx * da->elem_size) {
+			offset += da->elem_size;
+		}
+		elem = (unsigned char*)da->data + offset;
+	}
+	da__any_copy(it, elem, da->elem_size);
+	++da->size;
+	return DA_SUCCESS;
+}
+
+da_errno_type da_any_erase(da_any_type* da, size_t idx) {
+	if (DA__UNLIKELY(idx >= da->size)) {
+		return DA_OUT_OF_BOUNDS;
+	}
+	unsigned char* it = (unsigned char*)da->data + idx * da->elem_size;
+	memmove(
+		it, it + da->elem_size, (da->size - idx - 1) * da->elem_size
+	);
+	--da->size;
+	return DA_SUCCESS;
+}
@@ -0,0 +1,123 @@
+#ifndef UTILITY_DA_ANY_H_
+#define UTILITY_DA_ANY_H_
+
+#include <stddef.h>
+
+#include "da.h"
+
+/** Type-Erased Arrays *******************************************************/
+
+/**
+ * A dynamic array whose element size is only known at runtime, these members
+ * should not be modified directly.
+ *
+ * Unlike `da_type`, the operations are functions compiled once (in `da_any.c`)
+ * rather than macros, and elements are passed by pointer. Elements of 1, 2,
+ * 4, 8 and 16 bytes are copied with fixed size copies.
+ *
+ * There is no errnum: every function that can fail returns a
+ * `da_errno_type`. `DA_SIZE`, `DA_CAPACITY`, `DA_EMPTY`, `DA_CLEAR` and
+ * `DA_SET_GROWTH` also accept a `da_any_type`.
+ */
+typedef struct {
+	void* data;
+	size_t size;
+	size_t capacity;
+	/* NULL for the default allocator */
+	const da_allocator_type* allocator;
+	void* allocator_ctx;
+	/* NULL for DA_FACTOR_NUM/DEN and DA_BIAS */
+	const da_growth_type* growth;
+	size_t elem_size;
+} da_any_type;
+
+/**
+ * Initialises an array of `elem_size` byte elements, nothing is allocated.
+ *
+ * An `elem_size` of 0 is accepted, but every operation that allocates then
+ * fails with `DA_INVALID_SIZE`.
+ *
+ * @param         da       	A type-erased dynamic array object.
+ * @param         elem_size	The size of an element, in bytes.
+ */
+void da_any_create(da_any_type* da, size_t elem_size);
+
+/**
+ * As `da_any_create`, but the array allocates through `alloc`.
+ *
+ * @param         da       	A type-erased dynamic array object.
+ * @param         elem_size	The size of an element, in bytes.
+ * @param         alloc    	A pointer to a `da_allocator_type`, may be
+ *                         	`NULL`.
+ * @param         ctx      	The context passed to the allocator.
+ *
+ * @see	`DA_CREATE_WITH`
+ */
+void da_any_create_with(
+	da_any_type* da, size_t elem_size, const da_allocator_type* alloc,
+	void* ctx
+);
+
+/**
+ * Frees the memory of the array, the element size is kept.
+ *
+ * @param         da	A type-erased dynamic array object.
+ */
+void da_any_destroy(da_any_type* da);
+
+/**
+ * Reserves space for at least `n` elements.
+ *
+ * Returns `DA_SUCCESS`, `DA_INVALID_SIZE` or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da	A type-erased dynamic array object.
+ * @param         n 	The new capacity of the array.
+ */
+da_errno_type da_any_reserve(da_any_type* da, size_t n);
+
+/**
+ * Pointer to the element at index `idx`, only valid until the array is next
+ * modified.
+ *
+ * @param         da 	A type-erased dynamic array object.
+ * @param         idx	An index into the array.
+ *
+ * @return	the element, or `NULL` if `idx` is out of bounds
+ */
+void* da_any_get(const da_any_type* da, size_t idx);
+
+/**
+ * Appends a copy of the element at `elem` to the array, resizing if
+ * necessary. `elem` may point into the array itself.
+ *
+ * Returns `DA_SUCCESS`, `DA_INVALID_SIZE` or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da  	A type-erased dynamic array object.
+ * @param         elem	Pointer to the element to append.
+ */
+da_errno_type da_any_push_back(da_any_type* da, const void* elem);
+
+/**
+ * Inserts a copy of the element at `elem` before index `idx`.
+ *
+ * Returns `DA_SUCCESS`, `DA_OUT_OF_BOUNDS`, `DA_INVALID_SIZE` or
+ * `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da  	A type-erased dynamic array object.
+ * @param         idx 	An index into the array, up to its size.
+ * @param         elem	Pointer to the element to insert, may point into
+ *                    	the array.
+ */
+da_errno_type da_any_insert(da_any_type* da, size_t idx, const void* elem);
+
+/**
+ * Erases the element at index `idx` from the array.
+ *
+ * Returns `DA_SUCCESS` or `DA_OUT_OF_BOUNDS`.
+ *
+ * @param         da 	A type-erased dynamic array object.
+ * @param         idx	An index into the array.
+ */
+da_errno_type da_any_erase(da_any_type* da, size_t idx);
+
+#endif /* UTILITY_DA_ANY_H_ */
@@ -0,0 +1,181 @@
+#ifndef UTILITY_DA_ARENA_H_
+#define UTILITY_DA_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "da.h"
+
+/**
+ * The alignment of every allocation made from an arena.
+ */
+#ifndef DA_ARENA_ALIGNMENT
+#define DA_ARENA_ALIGNMENT 16
+#endif
+
+/** Arena ********************************************************************/
+
+/**
+ * A bump allocator for dynamic arrays, these members should not be modified
+ * directly.
+ *
+ * Arrays are created in an arena with `DA_CREATE_IN_ARENA`. The arena is a
+ * single fixed-size block: allocations are never freed individually, the
+ * whole arena is released at once with `DA_ARENA_RESET`.
+ */
+typedef struct {
+	unsigned char* base;
+	size_t size;
+	size_t offset;
+	/* the most recent allocation, which can grow in place */
+	unsigned char* last;
+} da_arena_type;
+
+/**
+ * Allocates the memory block for an arena.
+ *
+ * If the allocation fails, the base pointer of the arena is `NULL` and its
+ * size is 0, every allocation from it will fail with `DA_OUT_OF_MEMORY`.
+ *
+ * @param         arena	An arena object.
+ * @param         sz   	The size of the arena, in bytes.
+ *
+ * @see	`DA_ARENA_DESTROY`
+ */
+#define DA_ARENA_CREATE(arena, sz)                                            \
+do {                                                                          \
+	(arena).base = DA_MALLOC(sz);                                         \
+	(arena).size = ((arena).base == NULL) ? 0 : (size_t)(sz);             \
+	(arena).offset = 0;                                                   \
+	(arena).last = NULL;                                                  \
+} while (0)
+
+/**
+ * Frees the memory block of an arena, and with it every array created in it.
+ *
+ * @param         arena	An arena object.
+ *
+ * @see	`DA_ARENA_CREATE`
+ */
+#define DA_ARENA_DESTROY(arena)                                               \
+do {                                                                          \
+	DA_FREE((arena).base);                                                \
+	(arena).base = NULL;                                                  \
+	(arena).size = 0;                                                     \
+	(arena).offset = 0;                                                   \
+	(arena).last = NULL;                                                  \
+} while (0)
+
+/**
+ * Releases every allocation made from the arena, without free'ing memory.
+ *
+ * NOTE: every array created in the arena is invalidated, and must not be used
+ * again until it is re-created with `DA_CREATE_IN_ARENA`. There is no need
+ * to "call" `DA_DESTROY` on these arrays.
+ *
+ * @param         arena	An arena object.
+ */
+#define DA_ARENA_RESET(arena)                                                 \
+do {                                                                          \
+	(arena).offset = 0;                                                   \
+	(arena).last = NULL;                                                  \
+} while (0)
+
+/**
+ * Number of bytes in use in the arena (including padding and abandoned
+ * blocks).
+ *
+ * @param         arena	An arena object.
+ */
+#define DA_ARENA_USED(arena) (arena).offset
+
+/**
+ * Allocates `size` bytes from the arena.
+ *
+ * @param         arena	The arena.
+ * @param         size 	The size of the block, in bytes.
+ *
+ * @return	the new block, or `NULL` if the arena is full
+ */
+static inline void* da_arena_alloc(da_arena_type* arena, size_t size) {
+	size_t start = arena->offset;
+	size_t align = DA_ARENA_ALIGNMENT;
+	start = (start + align - 1) / align * align;
+	if (start > arena->size || size > arena->size - start) {
+		return NULL;
+	}
+	arena->last = arena->base + start;
+	arena->offset = start + size;
+	return arena->last;
+}
+
+/**
+ * `da_allocator_type::reallocate` for arenas.
+ *
+ * The most recent allocation is extended (or shrunk) in place, any other
+ * block is copied to the end of the arena and the old copy is abandoned until
+ * the arena is reset.
+ */
+static inline void* da__arena_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	da_arena_type* arena = ctx;
+	unsigned char* block = ptr;
+
+	if (block != NULL && block == arena->last) {
+		size_t start = (size_t)(block - arena->base);
+		if (new_size > arena->size - start) {
+			return NULL;
+		}
+		arena->offset = start + new_size;
+		return block;
+	}
+	if (block != NULL && new_size <= old_size) {
+		return block;
+	}
+
+	void* new_block = da_arena_alloc(arena, new_size);
+	if (new_block != NULL && block != NULL) {
+		memcpy(new_block, block, old_size);
+	}
+	return new_block;
+}
+
+/**
+ * `da_allocator_type::deallocate` for arenas, only the most recent allocation
+ * is given back.
+ */
+static inline void da__arena_deallocate(void* ctx, void* ptr, size_t size) {
+	da_arena_type* arena = ctx;
+	(void)size;
+
+	if (ptr != NULL && ptr == arena->last) {
+		arena->offset = (size_t)(arena->last - arena->base);
+		arena->last = NULL;
+	}
+}
+
+/**
+ * The allocator used by arrays that are created in an arena.
+ */
+static const da_allocator_type da_arena_allocator = {
+	da__arena_reallocate, da__arena_deallocate
+};
+
+/**
+ * As `DA_CREATE`, the array will allocate all of its memory from the arena.
+ *
+ * If the array is the most recent allocation made from the arena it grows in
+ * place, without copying.
+ *
+ * @param         da   	A dynamic array object.
+ * @param         arena	An arena object.
+ *
+ * @see	`DA_CREATE_WITH`
+ * @see	`DA_ARENA_RESET`
+ */
+#define DA_CREATE_IN_ARENA(da, arena)                                         \
+	DA_CREATE_WITH(da, &da_arena_allocator, &(arena))
+
+#endif /* UTILITY_DA_ARENA_H_ */
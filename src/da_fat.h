@@ -0,0 +1,268 @@
+#ifndef UTILITY_DA_FAT_H_
+#define UTILITY_DA_FAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "da.h"
+
+/** Fat Pointers *************************************************************/
+
+/**
+ * The header stored immediately before the first element of a "fat pointer"
+ * array, these members should not be modified directly.
+ *
+ * The header is two `size_t`s, `2 * sizeof(size_t)` bytes with no padding, so
+ * the elements are aligned to `2 * sizeof(size_t)` within the block returned
+ * by `DA_MALLOC` (16 bytes on 64-bit targets, 8 on 32-bit ones). Types with a
+ * stricter alignment are not supported.
+ */
+typedef struct {
+	size_t size;
+	size_t capacity;
+} da_fat_header_type;
+
+/**
+ * A "fat pointer" dynamic array: a plain pointer to the first element, with
+ * the size and capacity stored in a header just before it.
+ *
+ * An empty array is a `NULL` pointer, so a zero-initialised array is valid and
+ * an embedded array costs one pointer. Elements are accessed by indexing the
+ * pointer directly, e.g. `arr[i]`.
+ *
+ * There is no errnum: every macro that can fail evaluates to a
+ * `da_errno_type`. Every macro that can grow the array may move it, so the
+ * array must be an lvalue.
+ *
+ * @param         value_type	the type of the array element
+ */
+#define da_fat_type(value_type) value_type*
+
+/**
+ * The header of a non-`NULL` fat pointer array.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA__FAT_HEADER(p) ((da_fat_header_type*)(void*)(p) - 1)
+
+/**
+ * Sets the capacity of a fat pointer array to at least `n` elements.
+ *
+ * @param         p        	pointer to the fat pointer array
+ * @param         n        	the new capacity
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__fat_reserve(
+	void** p, size_t n, size_t elem_size
+) {
+	da_fat_header_type* header = (*p == NULL) ? NULL : DA__FAT_HEADER(*p);
+	size_t capacity = (header == NULL) ? 0 : header->capacity;
+	size_t header_size = sizeof(da_fat_header_type);
+
+	if (n <= capacity) {
+		return DA_SUCCESS;
+	}
+	if (n > (SIZE_MAX - header_size) / elem_size) {
+		return DA_OUT_OF_MEMORY;
+	}
+	da_fat_header_type* block = DA_REALLOC(
+		header, header_size + n * elem_size
+	);
+	if (block == NULL) {
+		return DA_OUT_OF_MEMORY;
+	}
+	if (header == NULL) {
+		block->size = 0;
+	}
+	block->capacity = n;
+	*p = block + 1;
+	return DA_SUCCESS;
+}
+
+/**
+ * Grows a fat pointer array to hold at least `required` elements, following
+ * the growth curve of `da__next_capacity`.
+ *
+ * @param         p        	pointer to the fat pointer array
+ * @param         required 	the minimum new capacity
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__fat_grow(
+	void** p, size_t required, size_t elem_size
+) {
+	size_t capacity = (*p == NULL) ? 0 : DA__FAT_HEADER(*p)->capacity;
+	size_t n = da__next_capacity(capacity);
+
+	if (n < DA_INITIAL_CAPACITY) {
+		n = DA_INITIAL_CAPACITY;
+	}
+	if (n < required) {
+		n = required;
+	}
+	return da__fat_reserve(p, n, elem_size);
+}
+
+/**
+ * Resizes a fat pointer array, new elements are zero'd.
+ *
+ * @param         p        	pointer to the fat pointer array
+ * @param         n        	the new size
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__fat_resize(
+	void** p, size_t n, size_t elem_size
+) {
+	if (*p == NULL && n == 0) {
+		return DA_SUCCESS;
+	}
+	da_errno_type err = da__fat_reserve(p, n, elem_size);
+	if (err != DA_SUCCESS) {
+		return err;
+	}
+	da_fat_header_type* header = DA__FAT_HEADER(*p);
+	if (n > header->size) {
+		unsigned char* end = *p;
+		end += header->size * elem_size;
+		memset(end, 0, (n - header->size) * elem_size);
+	}
+	header->size = n;
+	return DA_SUCCESS;
+}
+
+/**
+ * Erases the element at index `idx` from a fat pointer array.
+ *
+ * @param         p        	the fat pointer array
+ * @param         idx      	index of the element to erase
+ * @param         elem_size	size of an element, in bytes
+ */
+static inline da_errno_type da__fat_erase(
+	void* p, size_t idx, size_t elem_size
+) {
+	if (p == NULL || idx >= DA__FAT_HEADER(p)->size) {
+		return DA_OUT_OF_BOUNDS;
+	}
+	da_fat_header_type* header = DA__FAT_HEADER(p);
+	unsigned char* it = (unsigned char*)p + idx * elem_size;
+	memmove(it, it + elem_size, (header->size - idx - 1) * elem_size);
+	--header->size;
+	return DA_SUCCESS;
+}
+
+/**
+ * Frees a fat pointer array and `NULL`'s the pointer.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_DESTROY(p)                                                     \
+do {                                                                          \
+	if ((p) != NULL) {                                                    \
+		DA_FREE(DA__FAT_HEADER(p));                                   \
+	}                                                                     \
+	(p) = NULL;                                                           \
+} while (0)
+
+/**
+ * Number of elements in the array.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_SIZE(p) (((p) == NULL) ? (size_t)0 : DA__FAT_HEADER(p)->size)
+
+/**
+ * Number of elements that can fit in the currently allocated array.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_CAPACITY(p)                                                    \
+	(((p) == NULL) ? (size_t)0 : DA__FAT_HEADER(p)->capacity)
+
+/**
+ * Checks if the array is empty.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_EMPTY(p) (DA_FAT_SIZE(p) == 0)
+
+/**
+ * Iterator pointing at the first element in the array.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_BEGIN(p) (p)
+
+/**
+ * Iterator pointing one past the last element in the array.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_END(p) ((p) + DA_FAT_SIZE(p))
+
+/**
+ * Reserves space for at least `n` elements.
+ *
+ * Evaluates to `DA_SUCCESS` or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         p	A fat pointer array.
+ * @param         n	The new capacity of the array.
+ */
+#define DA_FAT_RESERVE(p, n)                                                  \
+	da__fat_reserve((void**)&(p), (n), sizeof(*(p)))
+
+/**
+ * Resizes the array, new elements are zero'd.
+ *
+ * Evaluates to `DA_SUCCESS` or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         p	A fat pointer array.
+ * @param         n	The new size of the array.
+ */
+#define DA_FAT_RESIZE(p, n)                                                   \
+	da__fat_resize((void**)&(p), (n), sizeof(*(p)))
+
+/**
+ * Appends a new element to the array, resizing if necessary.
+ *
+ * Evaluates to `DA_SUCCESS` or `DA_OUT_OF_MEMORY`.
+ *
+ * @param         p   	A fat pointer array.
+ * @param         elem	The object to append to the array.
+ */
+#define DA_FAT_PUSH_BACK(p, elem)                                             \
+	(                                                                     \
+		(                                                             \
+			DA_FAT_SIZE(p) < DA_FAT_CAPACITY(p) ||                \
+			da__fat_grow(                                         \
+				(void**)&(p), DA_FAT_SIZE(p) + 1,             \
+				sizeof(*(p))                                  \
+			) == DA_SUCCESS                                       \
+		) ? (                                                         \
+			((p)[DA__FAT_HEADER(p)->size] = (elem)),              \
+			++DA__FAT_HEADER(p)->size,                            \
+			DA_SUCCESS                                            \
+		) : (                                                         \
+			DA_OUT_OF_MEMORY                                      \
+		)                                                             \
+	)
+
+/**
+ * Erases the element referenced by the iterator from the array.
+ *
+ * Evaluates to `DA_SUCCESS` or `DA_OUT_OF_BOUNDS`.
+ *
+ * @param         p 	A fat pointer array.
+ * @param         it	An iterator for the given array.
+ */
+#define DA_FAT_ERASE(p, it)                                                   \
+	da__fat_erase((p), (size_t)((it) - (p)), sizeof(*(p)))
+
+/**
+ * Clears the array, setting the size to 0, without free'ing memory.
+ *
+ * @param         p	A fat pointer array.
+ */
+#define DA_FAT_CLEAR(p)                                                       \
+	(((p) == NULL) ? (void)0 : (void)(DA__FAT_HEADER(p)->size = 0))
+
+#endif /* UTILITY_DA_FAT_H_ */
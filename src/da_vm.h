@@ -0,0 +1,252 @@
+#ifndef UTILITY_DA_VM_H_
+#define UTILITY_DA_VM_H_
+
+#include <stddef.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "da.h"
+
+/** Virtual Memory ***********************************************************/
+
+/**
+ * A reserved range of virtual memory for a single dynamic array, these members
+ * should not be modified directly.
+ *
+ * The whole range is reserved up front (`PROT_NONE`), pages are committed as
+ * the array grows. The array never moves, so growth does not copy and
+ * pointers and iterators into the array remain valid for its whole life.
+ *
+ * NOTE: only one array may be created in each reservation at a time.
+ */
+typedef struct {
+	unsigned char* base;
+	size_t reserved;
+	size_t committed;
+} da_vm_type;
+
+/**
+ * Reserves `sz` bytes of address space, no memory is committed.
+ *
+ * If the reservation fails, the base pointer is `NULL` and the reserved size
+ * is 0, every allocation from it will fail with `DA_OUT_OF_MEMORY`.
+ *
+ * @param         vm	A reservation object.
+ * @param         sz	The size of the reservation, in bytes.
+ *
+ * @see	`DA_VM_DESTROY`
+ */
+#define DA_VM_CREATE(vm, sz)                                                  \
+do {                                                                          \
+	size_t da_page = (size_t)sysconf(_SC_PAGESIZE);                       \
+	size_t da_bytes = ((size_t)(sz) + da_page - 1) / da_page * da_page;   \
+	void* da_base = mmap(                                                 \
+		NULL, da_bytes, PROT_NONE,                                    \
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0            \
+	);                                                                    \
+	if (da_base == MAP_FAILED) {                                          \
+		da_base = NULL;                                               \
+		da_bytes = 0;                                                 \
+	}                                                                     \
+	(vm).base = da_base;                                                  \
+	(vm).reserved = da_bytes;                                             \
+	(vm).committed = 0;                                                   \
+} while (0)
+
+/**
+ * Releases the reservation, and with it the array created in it.
+ *
+ * @param         vm	A reservation object.
+ *
+ * @see	`DA_VM_CREATE`
+ */
+#define DA_VM_DESTROY(vm)                                                     \
+do {                                                                          \
+	if ((vm).base != NULL) {                                              \
+		munmap((vm).base, (vm).reserved);                             \
+	}                                                                     \
+	(vm).base = NULL;                                                     \
+	(vm).reserved = 0;                                                    \
+	(vm).committed = 0;                                                   \
+} while (0)
+
+/**
+ * `da_allocator_type::reallocate` for reservations.
+ *
+ * Commits the pages required to hold `new_size` bytes, the block is always
+ * the start of the reservation. Pages are not decommitted when shrinking.
+ */
+static inline void* da__vm_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	da_vm_type* vm = ctx;
+	(void)ptr;
+	(void)old_size;
+
+	if (vm->base == NULL || new_size > vm->reserved) {
+		return NULL;
+	}
+	if (new_size > vm->committed) {
+		size_t page = (size_t)sysconf(_SC_PAGESIZE);
+		size_t bytes = (new_size + page - 1) / page * page;
+		int prot = PROT_READ | PROT_WRITE;
+		size_t len = bytes - vm->committed;
+		if (mprotect(vm->base + vm->committed, len, prot) != 0) {
+			return NULL;
+		}
+		vm->committed = bytes;
+	}
+	return vm->base;
+}
+
+/**
+ * `da_allocator_type::deallocate` for reservations, decommits every page but
+ * keeps the address space reserved.
+ */
+static inline void da__vm_deallocate(void* ctx, void* ptr, size_t size) {
+	da_vm_type* vm = ctx;
+	(void)ptr;
+	(void)size;
+
+	if (vm->committed > 0) {
+		madvise(vm->base, vm->committed, MADV_DONTNEED);
+		mprotect(vm->base, vm->committed, PROT_NONE);
+		vm->committed = 0;
+	}
+}
+
+/**
+ * The allocator used by arrays that are created in a reservation.
+ */
+static const da_allocator_type da_vm_allocator = {
+	da__vm_reallocate, da__vm_deallocate
+};
+
+/**
+ * As `DA_CREATE`, the array will commit its memory from the reservation.
+ *
+ * The capacity of the array is limited by the size of the reservation,
+ * growing past it sets the errnum to `DA_OUT_OF_MEMORY`.
+ *
+ * @param         da	A dynamic array object.
+ * @param         vm	A reservation object.
+ *
+ * @see	`DA_CREATE_WITH`
+ */
+#define DA_CREATE_IN_VM(da, vm)                                               \
+	DA_CREATE_WITH(da, &da_vm_allocator, &(vm))
+
+/** mremap *******************************************************************/
+
+/**
+ * `mremap` is only available on Linux, and only declared if `_GNU_SOURCE` is
+ * defined before the first system header is included.
+ */
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+
+#include <string.h>
+
+/**
+ * Blocks of at least this many bytes are allocated with `mmap` and grown with
+ * `mremap`, smaller blocks are allocated with `DA_REALLOC`.
+ *
+ * See the "push_back_mremap" records of `make bench` for the crossover point
+ * on a given machine.
+ */
+#ifndef DA_MREMAP_THRESHOLD
+#define DA_MREMAP_THRESHOLD ((size_t)1 << 25)
+#endif
+
+/**
+ * Rounds a size up to a whole number of pages.
+ */
+static inline size_t da__vm_pages(size_t size) {
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	return (size + page - 1) / page * page;
+}
+
+/**
+ * `da_allocator_type::reallocate` for `mremap`.
+ *
+ * Whether a block was mapped is decided by its size alone, `ctx` may point to
+ * a `size_t` threshold, or be `NULL` to use `DA_MREMAP_THRESHOLD`.
+ */
+static inline void* da__mremap_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	size_t threshold = (ctx == NULL) ? DA_MREMAP_THRESHOLD : *(size_t*)ctx;
+	int old_mapped = (ptr != NULL && old_size >= threshold);
+	int new_mapped = (new_size >= threshold);
+	void* block = NULL;
+
+	if (!old_mapped && !new_mapped) {
+		return DA_REALLOC(ptr, new_size);
+	}
+	if (old_mapped && new_mapped) {
+		block = mremap(
+			ptr, da__vm_pages(old_size), da__vm_pages(new_size),
+			MREMAP_MAYMOVE
+		);
+		return (block == MAP_FAILED) ? NULL : block;
+	}
+
+	/* crossing the threshold, copy between the two kinds of block */
+	size_t copy_size = (old_size < new_size) ? old_size : new_size;
+	if (new_mapped) {
+		block = mmap(
+			NULL, da__vm_pages(new_size), PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+		);
+		if (block == MAP_FAILED) {
+			return NULL;
+		}
+		if (ptr != NULL) {
+			memcpy(block, ptr, copy_size);
+			DA_FREE(ptr);
+		}
+		return block;
+	}
+	block = DA_MALLOC(new_size);
+	if (block == NULL) {
+		return NULL;
+	}
+	memcpy(block, ptr, copy_size);
+	munmap(ptr, da__vm_pages(old_size));
+	return block;
+}
+
+/**
+ * `da_allocator_type::deallocate` for `mremap`.
+ */
+static inline void da__mremap_deallocate(void* ctx, void* ptr, size_t size) {
+	size_t threshold = (ctx == NULL) ? DA_MREMAP_THRESHOLD : *(size_t*)ctx;
+
+	if (size >= threshold) {
+		munmap(ptr, da__vm_pages(size));
+		return;
+	}
+	DA_FREE(ptr);
+}
+
+/**
+ * The allocator used by arrays that grow with `mremap`.
+ */
+static const da_allocator_type da_mremap_allocator = {
+	da__mremap_reallocate, da__mremap_deallocate
+};
+
+/**
+ * As `DA_CREATE`, once the array is larger than `DA_MREMAP_THRESHOLD` bytes it
+ * is backed by an anonymous mapping that is grown with `mremap`, so the kernel
+ * moves pages instead of the array being copied.
+ *
+ * @param         da	A dynamic array object.
+ *
+ * @see	`DA_CREATE_WITH`
+ */
+#define DA_CREATE_MREMAP(da)                                                  \
+	DA_CREATE_WITH(da, &da_mremap_allocator, NULL)
+
+#endif /* __linux__ && MREMAP_MAYMOVE */
+
+#endif /* UTILITY_DA_VM_H_ */
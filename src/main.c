@@ -1,8 +1,15 @@
+#define _GNU_SOURCE
+
 #include <ctype.h>
 #include <stdio.h>
 #include <stdint.h>
 
 #include "da.h"
+#include "da32.h"
+#include "da_any.h"
+#include "da_arena.h"
+#include "da_fat.h"
+#include "da_vm.h"
 
 #define DA_PRINT(da)                                                          \
 do {                                                                          \
@@ -16,6 +23,47 @@ do {                                                                          \
 	printf("]\n");                                                        \
 } while (0)
 
+/* counts the bytes held by arrays that use it */
+static void* tracking_reallocate(
+	void* ctx, void* ptr, size_t old_size, size_t new_size
+) {
+	void* p = realloc(ptr, new_size);
+	if (p != NULL) {
+		*(size_t*)ctx += new_size - old_size;
+	}
+	return p;
+}
+
+static void tracking_deallocate(void* ctx, void* ptr, size_t size) {
+	*(size_t*)ctx -= size;
+	free(ptr);
+}
+
+static const da_allocator_type tracking_allocator = {
+	tracking_reallocate, tracking_deallocate
+};
+
+/*
+ * The capacity of an array on the default allocator, after its block was
+ * (re)allocated for `n` elements: with DA_USABLE_SIZE, the whole usable block.
+ */
+#ifdef DA_USABLE_SIZE
+#define ALLOCATED_CAPACITY(da, n)                                             \
+	(DA_USABLE_SIZE(DA_DATA(da)) / sizeof(DA_DATA(da)[0]))
+#else
+#define ALLOCATED_CAPACITY(da, n) ((size_t)(n))
+#endif
+
+DA_DEFINE(int_array, int);
+
+/* grows by 10 elements, counting the calls in ctx */
+static size_t counting_growth(
+	const da_growth_type* growth, size_t capacity, size_t required
+) {
+	(void)required;
+	++*(size_t*)growth->ctx;
+	return capacity + 10;
+}
 
 int main(void) {
 	/** "demo" ***********************************************************/
@@ -234,8 +282,9 @@ int main(void) {
 	}
 	printf(" out of bounds (negative)\n");
 
-	for (da_iter_type(da) it = &DA_BACK(da); it != DA_BEGIN(da); --it) {
-		DA_ERASE(da, it);
+	/* erasing may shrink the array, so no iterator is kept across it */
+	while (DA_SIZE(da) > 1) {
+		DA_ERASE(da, &DA_BACK(da));
 	}
 	// DA_PRINT(da);
 	if (DA_ERRNO(da) == DA_SUCCESS && (DA_SIZE(da) == 1)) {
@@ -259,7 +308,1224 @@ int main(void) {
 	}
 	printf(" push_back\n");
 
+	/** DA_*_UNCHECKED ***************************************************/
+	printf("---------- DA_*_UNCHECKED --------------------------------\n");
+	DA_RESERVE(da, DA_SIZE(da) + 1);
+	DA_PUSH_BACK_UNCHECKED(da, 42);
+	DA_SET_UNCHECKED(da, DA_SIZE(da) - 1, 7);
+	res = DA_GET_UNCHECKED(da, DA_SIZE(da) - 1);
+	// DA_PRINT(da);
+	if (DA_ERRNO(da) == DA_SUCCESS && res == 7) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_*_UNCHECKED");
+		printf("[ fail ]");
+	}
+	printf(" push_back, set & get\n");
+
+	DA_ERASE(da, &DA_BACK(da));
+
+	/** DA_INSERT_N ******************************************************/
+	printf("---------- DA_INSERT_N -----------------------------------\n");
+	char block[3] = {1, 2, 3};
+	size_t old_size = DA_SIZE(da);
+	char old_back = DA_BACK(da);
+
+	DA_INSERT_N(da, DA_END(da) + 1, block, 3);
+	// DA_PRINT(da);
+	if (DA_ERRNO(da) == DA_OUT_OF_BOUNDS) {
+		DA_PERROR(da, "DA_INSERT_N");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" out of bounds (too high)\n");
+
+	DA_INSERT_N(da, DA_END(da) - 1, block, 3);
+	// DA_PRINT(da);
+	if (
+		DA_ERRNO(da) == DA_SUCCESS && DA_SIZE(da) == old_size + 3 &&
+		DA_DATA(da)[old_size - 1] == 1 &&
+		DA_DATA(da)[old_size + 1] == 3 &&
+		DA_BACK(da) == old_back
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_INSERT_N");
+		printf("[ fail ]");
+	}
+	printf(" insert block & reset errno\n");
+
+	/** DA_ERASE_RANGE ***************************************************/
+	printf("---------- DA_ERASE_RANGE --------------------------------\n");
+	DA_ERASE_RANGE(da, DA_BEGIN(da) + 2, DA_BEGIN(da) + 1);
+	// DA_PRINT(da);
+	if (DA_ERRNO(da) == DA_INVALID_ITERATOR) {
+		DA_PERROR(da, "DA_ERASE_RANGE");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" invalid range\n");
+
+	DA_ERASE_RANGE(da, DA_BEGIN(da), DA_END(da) + 1);
+	// DA_PRINT(da);
+	if (DA_ERRNO(da) == DA_OUT_OF_BOUNDS) {
+		DA_PERROR(da, "DA_ERASE_RANGE");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" out of bounds (too high)\n");
+
+	DA_ERASE_RANGE(da, DA_END(da) - 4, DA_END(da) - 1);
+	// DA_PRINT(da);
+	if (
+		DA_ERRNO(da) == DA_SUCCESS && DA_SIZE(da) == old_size &&
+		DA_BACK(da) == old_back
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_ERASE_RANGE");
+		printf("[ fail ]");
+	}
+	printf(" erase range & reset errno\n");
+
+	/** DA_APPEND_N ******************************************************/
+	printf("---------- DA_APPEND_N -----------------------------------\n");
+	DA_APPEND_N(da, block, 3);
+	// DA_PRINT(da);
+	if (
+		DA_ERRNO(da) == DA_SUCCESS && DA_SIZE(da) == old_size + 3 &&
+		DA_DATA(da)[old_size] == 1 && DA_BACK(da) == 3
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_APPEND_N");
+		printf("[ fail ]");
+	}
+	printf(" append & reset errno\n");
+
+	/* size + n would wrap */
+	size_t appended_size = DA_SIZE(da);
+	size_t wrap = SIZE_MAX - appended_size + 1;
+	DA_APPEND_N(da, block, wrap);
+	DA_INSERT_N(da, DA_BEGIN(da), block, wrap + 1);
+	if (DA_ERRNO(da) == DA_OUT_OF_MEMORY && DA_SIZE(da) == appended_size) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" count overflow\n");
+
+	/** DA_APPEND_ARRAY **************************************************/
+	printf("---------- DA_APPEND_ARRAY -------------------------------\n");
+	DA_APPEND_ARRAY(da, da);
+	// DA_PRINT(da);
+	if (
+		DA_ERRNO(da) == DA_SUCCESS &&
+		DA_SIZE(da) == 2 * (old_size + 3) &&
+		DA_DATA(da)[old_size + 3] == DA_FRONT(da) && DA_BACK(da) == 3
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_APPEND_ARRAY");
+		printf("[ fail ]");
+	}
+	printf(" append self & reset errno\n");
+
+	DA_DESTROY(da);
+
+	/** DA_CREATE_WITH ***************************************************/
+	printf("---------- DA_CREATE_WITH --------------------------------\n");
+	size_t bytes_in_use = 0;
+	DA_CREATE_WITH(da, &tracking_allocator, &bytes_in_use);
+	for (int i = 0; i < 100; ++i) {
+		DA_PUSH_BACK(da, (char)i);
+	}
+	if (
+		DA_ERRNO(da) == DA_SUCCESS &&
+		bytes_in_use == DA_CAPACITY(da) * sizeof(DA_FRONT(da))
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(da, "DA_CREATE_WITH");
+		printf("[ fail ]");
+	}
+	printf(" allocate through allocator\n");
+
+	DA_DESTROY(da);
+	if (bytes_in_use == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" free through allocator\n");
+
+	/** DA_CREATE_IN_ARENA ***********************************************/
+	printf("---------- DA_CREATE_IN_ARENA ----------------------------\n");
+	da_arena_type arena;
+	DA_ARENA_CREATE(arena, 256);
+	da_type(int) a;
+	da_type(int) b;
+
+	DA_CREATE_IN_ARENA(a, arena);
+	DA_CREATE_IN_ARENA(b, arena);
+	DA_PUSH_BACK(b, 1);
+	int* b_data = DA_DATA(b);
+	for (int i = 0; i < 16; ++i) {
+		DA_PUSH_BACK(b, i);
+	}
+	if (DA_ERRNO(b) == DA_SUCCESS && DA_DATA(b) == b_data) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(b, "DA_CREATE_IN_ARENA");
+		printf("[ fail ]");
+	}
+	printf(" grow last allocation in place\n");
+
+	DA_PUSH_BACK(a, 1);
+	DA_PUSH_BACK(a, 2);
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_BACK(a) == 2) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_IN_ARENA");
+		printf("[ fail ]");
+	}
+	printf(" grow by copy\n");
+
+	for (int i = 0; i < 256; ++i) {
+		DA_PUSH_BACK(b, i);
+	}
+	if (DA_ERRNO(b) == DA_OUT_OF_MEMORY) {
+		DA_PERROR(b, "DA_CREATE_IN_ARENA");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" arena full\n");
+
+	DA_ARENA_RESET(arena);
+	if (DA_ARENA_USED(arena) == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reset arena\n");
+
+	DA_ARENA_DESTROY(arena);
+
+	/* 48 is not on the growth curve, the whole arena must still be used */
+	DA_ARENA_CREATE(arena, 48 * sizeof(int));
+	DA_CREATE_IN_ARENA(a, arena);
+	for (int i = 0; i < 48; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 48 &&
+		DA_ARENA_USED(arena) == 48 * sizeof(int)
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_IN_ARENA");
+		printf("[ fail ]");
+	}
+	printf(" fill arena to the byte\n");
+
+	DA_PUSH_BACK(a, 48);
+	if (DA_ERRNO(a) == DA_OUT_OF_MEMORY && DA_SIZE(a) == 48) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" full arena\n");
+
+	DA_ARENA_DESTROY(arena);
+
+	/** DA_CREATE_IN_VM **************************************************/
+	printf("---------- DA_CREATE_IN_VM -------------------------------\n");
+	da_vm_type vm;
+	DA_VM_CREATE(vm, 1 << 20);
+
+	DA_CREATE_IN_VM(a, vm);
+	DA_PUSH_BACK(a, 0);
+	int* a_data = DA_DATA(a);
+	for (int i = 1; i < 100000; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_DATA(a) == a_data &&
+		DA_BACK(a) == 99999
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_IN_VM");
+		printf("[ fail ]");
+	}
+	printf(" grow without moving\n");
+
+	DA_RESERVE(a, 1 << 20);
+	if (DA_ERRNO(a) == DA_OUT_OF_MEMORY && DA_BACK(a) == 99999) {
+		DA_PERROR(a, "DA_CREATE_IN_VM");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reservation full\n");
+
+	DA_DESTROY(a);
+	DA_VM_DESTROY(vm);
+
+	/* 12 KiB (3072 ints with 4 KiB pages) is not on the growth curve */
+	DA_VM_CREATE(vm, 12 * 1024);
+	DA_CREATE_IN_VM(a, vm);
+	size_t vm_count = vm.reserved / sizeof(int);
+	for (size_t i = 0; i < vm_count; ++i) {
+		DA_PUSH_BACK(a, (int)i);
+	}
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == vm_count) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_IN_VM");
+		printf("[ fail ]");
+	}
+	printf(" fill reservation\n");
+
+	DA_PUSH_BACK(a, 0);
+	if (DA_ERRNO(a) == DA_OUT_OF_MEMORY && DA_SIZE(a) == vm_count) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" grow past the reservation\n");
+
+	DA_DESTROY(a);
+	DA_VM_DESTROY(vm);
+
+	/** DA_CREATE_MREMAP *************************************************/
+	printf("---------- DA_CREATE_MREMAP ------------------------------\n");
+	size_t threshold = 4096;
+	DA_CREATE_WITH(a, &da_mremap_allocator, &threshold);
+	for (int i = 0; i < 100000; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	res = 0;
+	for (int i = 0; i < 100000; ++i) {
+		res += (DA_GET(a, i) != i);
+	}
+	if (DA_ERRNO(a) == DA_SUCCESS && res == 0) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_MREMAP");
+		printf("[ fail ]");
+	}
+	printf(" grow past threshold\n");
+
+	DA_RESIZE(a, 10);
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_BACK(a) == 9) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_CREATE_MREMAP");
+		printf("[ fail ]");
+	}
+	printf(" shrink below threshold\n");
+
+	DA_DESTROY(a);
+
+	/** DA_SMALL_CREATE **************************************************/
+	printf("---------- DA_SMALL_CREATE -------------------------------\n");
+	da_small_type(int, 4) small;
+	DA_SMALL_CREATE(small);
+	for (int i = 0; i < 4; ++i) {
+		DA_PUSH_BACK(small, i);
+	}
+	if (
+		DA_ERRNO(small) == DA_SUCCESS &&
+		DA_DATA(small) == small.small && DA_BACK(small) == 3
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(small, "DA_SMALL_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" push_back inline\n");
+
+	for (int i = 4; i < 100; ++i) {
+		DA_PUSH_BACK(small, i);
+	}
+	res = 0;
+	for (int i = 0; i < 100; ++i) {
+		res += (DA_GET(small, i) != i);
+	}
+	if (
+		DA_ERRNO(small) == DA_SUCCESS && res == 0 &&
+		DA_DATA(small) != small.small && DA_SIZE(small) == 100
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(small, "DA_SMALL_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" spill to heap\n");
+
+	DA_DESTROY(small);
+
+	/* a reduced capacity must not spill elements that still fit inline */
+	da_small_type(int, 8) eight;
+	DA_SMALL_CREATE(eight);
+	for (int i = 0; i < 4; ++i) {
+		DA_PUSH_BACK(eight, i);
+	}
+	DA_RESIZE(eight, 2);
+	DA_PUSH_BACK(eight, 2);
+	DA_PUSH_BACK(eight, 3);
+	DA_SHRINK_TO_FIT(eight);
+	DA_PUSH_BACK(eight, 4);
+	if (
+		DA_ERRNO(eight) == DA_SUCCESS && DA_SIZE(eight) == 5 &&
+		DA_DATA(eight) == eight.small && DA_BACK(eight) == 4
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" shrink & regrow inline\n");
+	DA_DESTROY(eight);
+
+	/** DA_STATIC_CREATE *************************************************/
+	printf("---------- DA_STATIC_CREATE ------------------------------\n");
+	da_static_type(int, 8) fixed;
+	DA_STATIC_CREATE(fixed);
+	for (int i = 0; i < 8; ++i) {
+		DA_PUSH_BACK(fixed, i);
+	}
+	if (
+		DA_ERRNO(fixed) == DA_SUCCESS &&
+		DA_DATA(fixed) == fixed.storage && DA_BACK(fixed) == 7
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(fixed, "DA_STATIC_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" push_back to capacity\n");
+
+	DA_PUSH_BACK(fixed, 8);
+	if (DA_ERRNO(fixed) == DA_OUT_OF_MEMORY && DA_SIZE(fixed) == 8) {
+		DA_PERROR(fixed, "DA_STATIC_CREATE");
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" full\n");
+
+	DA_RESIZE(fixed, 2);
+	DA_RESIZE(fixed, 8);
+	if (DA_ERRNO(fixed) == DA_SUCCESS && DA_DATA(fixed) == fixed.storage) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(fixed, "DA_STATIC_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" shrink & regrow\n");
+
+	/* a lowered capacity must not hide the free storage */
+	DA_RESIZE(fixed, 5);
+	for (int i = 5; i < 8; ++i) {
+		DA_PUSH_BACK(fixed, i);
+	}
+	if (DA_ERRNO(fixed) == DA_SUCCESS && DA_SIZE(fixed) == 8) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(fixed, "DA_STATIC_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" resize down & refill\n");
+
+	DA_DESTROY(fixed);
+
+	/* 6 is not on the growth curve */
+	da_static_type(int, 6) six;
+	DA_STATIC_CREATE(six);
+	DA_SHRINK_TO_FIT(six);
+	for (int i = 0; i < 6; ++i) {
+		DA_PUSH_BACK(six, i);
+	}
+	if (
+		DA_ERRNO(six) == DA_SUCCESS && DA_SIZE(six) == 6 &&
+		DA_DATA(six) == six.storage && DA_BACK(six) == 5
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(six, "DA_STATIC_CREATE");
+		printf("[ fail ]");
+	}
+	printf(" shrink to fit & refill\n");
+	DA_DESTROY(six);
+
+	/** DA_FAT_* *********************************************************/
+	printf("---------- DA_FAT_* --------------------------------------\n");
+	da_fat_type(int) fat = NULL;
+	da_errno_type err = DA_SUCCESS;
+	for (int i = 0; i < 100 && err == DA_SUCCESS; ++i) {
+		err = DA_FAT_PUSH_BACK(fat, i);
+	}
+	if (
+		err == DA_SUCCESS && DA_FAT_SIZE(fat) == 100 &&
+		fat[0] == 0 && fat[99] == 99
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" push_back & index\n");
+
+	err = DA_FAT_ERASE(fat, DA_FAT_END(fat));
+	if (err == DA_OUT_OF_BOUNDS) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase out of bounds\n");
+
+	err = DA_FAT_ERASE(fat, DA_FAT_BEGIN(fat));
+	if (err == DA_SUCCESS && DA_FAT_SIZE(fat) == 99 && fat[0] == 1) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase\n");
+
+	err = DA_FAT_RESIZE(fat, 200);
+	if (err == DA_SUCCESS && DA_FAT_SIZE(fat) == 200 && fat[199] == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" resize\n");
+
+	DA_FAT_CLEAR(fat);
+	DA_FAT_DESTROY(fat);
+	if (DA_FAT_EMPTY(fat) && fat == NULL) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" destroy\n");
+
+	/** da_type32 ********************************************************/
+	printf("---------- da_type32 -------------------------------------\n");
+	da_type32(int) c;
+	DA32_CREATE(c);
+	if (sizeof(c) == sizeof(int*) + 2 * sizeof(uint32_t)) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" compact header\n");
+
+	err = DA_SUCCESS;
+	for (int i = 0; i < 100 && err == DA_SUCCESS; ++i) {
+		err = DA32_PUSH_BACK(c, i);
+	}
+	if (
+		err == DA_SUCCESS && DA_SIZE(c) == 100 &&
+		DA_FRONT(c) == 0 && DA_BACK(c) == 99
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" push_back & shared accessors\n");
+
+	if (SIZE_MAX > UINT32_MAX) {
+		err = DA32_RESERVE(c, (size_t)UINT32_MAX + 1);
+	} else {
+		err = DA_INVALID_SIZE;
+	}
+	if (err == DA_INVALID_SIZE && DA_CAPACITY(c) >= 100) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reserve overflow\n");
+
+	err = DA32_ERASE(c, DA_BEGIN(c));
+	if (err == DA_SUCCESS && DA_SIZE(c) == 99 && DA_FRONT(c) == 1) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase\n");
+
+	err = DA32_RESIZE(c, 200);
+	if (err == DA_SUCCESS && DA_SIZE(c) == 200 && DA_BACK(c) == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" resize\n");
+
+	DA32_CLEAR(c);
+	DA32_DESTROY(c);
+	if (DA_EMPTY(c) && DA_DATA(c) == NULL && DA_CAPACITY(c) == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" destroy\n");
+
+	/** DA_SET_GROWTH ****************************************************/
+	printf("---------- DA_SET_GROWTH ---------------------------------\n");
+	static const da_growth_type linear = DA_GROWTH_LINEAR(2, 1, 0, 16, 16);
+	/* an explicit allocator, so that capacities are exactly the policy's */
+	DA_CREATE_WITH(a, &tracking_allocator, &bytes_in_use);
+	DA_SET_GROWTH(a, &linear);
+	for (int i = 0; i < 100; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	/* 1, 2, 4, 8, 16, then linear: 32, 48, 64, 80, 96, 112 */
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_CAPACITY(a) == 112) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_SET_GROWTH");
+		printf("[ fail ]");
+	}
+	printf(" linear above threshold\n");
+
+	DA_RESERVE(a, 13);
+	DA_RESIZE(a, 13);
+	DA_SET_GROWTH(a, &da_growth_golden);
+	DA_PUSH_BACK(a, 13);
+	if (DA_CAPACITY(a) == 22 && DA_BACK(a) == 13) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" golden ratio\n");
+	DA_DESTROY(a);
+
+	size_t calls = 0;
+	da_growth_type custom = DA_GROWTH_CUSTOM(counting_growth, &calls);
+	DA_CREATE_WITH(a, &tracking_allocator, &bytes_in_use);
+	DA_SET_GROWTH(a, &custom);
+	for (int i = 0; i < 100; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	if (calls == 10 && DA_CAPACITY(a) == 100) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" custom\n");
+	DA_DESTROY(a);
+
+	DA_CREATE_WITH(a, &tracking_allocator, &bytes_in_use);
+	DA_PUSH_BACK(a, 0);
+	DA_PUSH_BACK(a, 1);
+	DA_PUSH_BACK(a, 2);
+	if (a.growth == NULL && DA_CAPACITY(a) == 4) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" default\n");
+	DA_DESTROY(a);
+
+	/* 3 is off the power of two curve, 2/1 must give exactly 6 */
+	DA_CREATE_WITH(a, &tracking_allocator, &bytes_in_use);
+	DA_RESERVE(a, 3);
+	for (int i = 0; i < 4; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	size_t after_3 = DA_CAPACITY(a);
+	for (int i = 4; i < 7; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && after_3 == 6 &&
+		DA_CAPACITY(a) == 12 && DA_BACK(a) == 6
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" rational default\n");
+	DA_DESTROY(a);
+
+	/** DA_USABLE_SIZE ***************************************************/
+	printf("---------- DA_USABLE_SIZE --------------------------------\n");
+	if (
+		da__size_class(1, 1) == 16 &&
+		da__size_class(100, 1) == 112 &&
+		da__size_class(129, 1) == 160 &&
+		da__size_class(1000, 1) == 1024 &&
+		da__size_class(3, 4) == 4 && da__size_class(5, 3) == 5 &&
+		da__size_class(SIZE_MAX, 2) == SIZE_MAX
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" size classes\n");
+
+#ifdef DA_USABLE_SIZE
+	/* a single char asks for the smallest size class, 16 bytes */
+	DA_CREATE(da);
+	DA_PUSH_BACK(da, 'x');
+	if (
+		DA_ERRNO(da) == DA_SUCCESS && DA_CAPACITY(da) >= 16 &&
+		DA_CAPACITY(da) == DA_USABLE_SIZE(DA_DATA(da))
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" growth takes the usable block\n");
 	DA_DESTROY(da);
+#endif
+
+	/** DA_SHRINK_TO_FIT *************************************************/
+	printf("---------- DA_SHRINK_TO_FIT ------------------------------\n");
+	DA_CREATE(a);
+	for (int i = 0; i < 1000; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	DA_ERASE_RANGE(a, DA_BEGIN(a) + 10, DA_END(a));
+	DA_SHRINK_TO_FIT(a);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS &&
+		DA_CAPACITY(a) == ALLOCATED_CAPACITY(a, 10) &&
+		DA_SIZE(a) == 10 && DA_BACK(a) == 9
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_SHRINK_TO_FIT");
+		printf("[ fail ]");
+	}
+	printf(" shrink\n");
+
+	DA_CLEAR(a);
+	DA_SHRINK_TO_FIT(a);
+	DA_PUSH_BACK(a, 1);
+	if (
+		DA_CAPACITY(a) == ALLOCATED_CAPACITY(a, DA_INITIAL_CAPACITY) &&
+		DA_FRONT(a) == 1
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" empty\n");
+	DA_DESTROY(a);
+
+#ifdef DA_AUTO_SHRINK
+	/* a queue drained through DA_ERASE gives its memory back */
+	DA_CREATE(a);
+	for (int i = 0; i < 1000; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	size_t full_capacity = DA_CAPACITY(a);
+	while (DA_SIZE(a) > 1) {
+		DA_ERASE(a, DA_BEGIN(a));
+	}
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_FRONT(a) == 999 &&
+		DA_CAPACITY(a) < full_capacity / 8
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase shrinks\n");
+
+	/* a shrunk array is at most half full, so it does not regrow at once */
+	while (DA_SIZE(a) < 1000) {
+		DA_PUSH_BACK(a, 1);
+	}
+	full_capacity = DA_CAPACITY(a);
+	while (DA_SIZE(a) >= full_capacity / 4) {
+		DA_SWAP_REMOVE(a, DA_BEGIN(a));
+	}
+	size_t shrunk_capacity = DA_CAPACITY(a);
+	DA_PUSH_BACK(a, 1);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && shrunk_capacity < full_capacity &&
+		DA_SIZE(a) <= shrunk_capacity / 2 &&
+		DA_CAPACITY(a) == shrunk_capacity
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" swap remove shrinks, with hysteresis\n");
+
+	DA_ERASE_IF(a, it, 1);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 0 &&
+		DA_CAPACITY(a) < shrunk_capacity
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" bulk erase shrinks\n");
+	DA_DESTROY(a);
+#endif
+
+	/** DA_RESIZE_UNINIT & DA_CLEAR_ZERO *********************************/
+	printf("---------- DA_RESIZE_UNINIT & DA_CLEAR_ZERO --------------\n");
+	DA_CREATE(a);
+	DA_RESIZE_UNINIT(a, 100);
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 100) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_RESIZE_UNINIT");
+		printf("[ fail ]");
+	}
+	printf(" resize uninit\n");
+
+	for (int i = 0; i < 100; ++i) {
+		DA_SET_UNCHECKED(a, i, i + 1);
+	}
+	DA_CLEAR(a);
+	if (
+		DA_EMPTY(a) && DA_CAPACITY(a) == ALLOCATED_CAPACITY(a, 100) &&
+		DA_DATA(a)[99] == 100
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" clear only resets size\n");
+
+	DA_RESIZE(a, 50);
+	if (DA_SIZE(a) == 50 && DA_FRONT(a) == 0 && DA_BACK(a) == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" resize zeroes new elements\n");
+
+	/* dirty the spare capacity, then grow by an expression of the size */
+	DA_RESERVE(a, 64);
+	for (size_t i = 0; i < DA_CAPACITY(a); ++i) {
+		DA_DATA(a)[i] = -1;
+	}
+	DA_SIZE(a) = 7;
+	DA_RESIZE(a, DA_SIZE(a) + 4);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 11 &&
+		DA_DATA(a)[6] == -1 && DA_DATA(a)[7] == 0 && DA_BACK(a) == 0
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" resize by an expression of the size\n");
+
+	DA_SET(a, 0, 42);
+	DA_CLEAR_ZERO(a);
+	if (DA_EMPTY(a) && DA_DATA(a)[0] == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" clear zero\n");
+	DA_DESTROY(a);
+
+	/** DA_INIT **********************************************************/
+	printf("---------- DA_INIT ---------------------------------------\n");
+	da_type(int) lazy = DA_INIT;
+	if (DA_DATA(lazy) == NULL && DA_CAPACITY(lazy) == 0 && DA_EMPTY(lazy)) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" nothing allocated\n");
+
+	DA_GET(lazy, 0);
+	DA_ERASE(lazy, DA_BEGIN(lazy));
+	DA_CLEAR_ZERO(lazy);
+	DA_SHRINK_TO_FIT(lazy);
+	if (DA_ERRNO(lazy) == DA_SUCCESS && DA_DATA(lazy) == NULL) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(lazy, "DA_INIT");
+		printf("[ fail ]");
+	}
+	printf(" empty operations\n");
+
+	DA_PUSH_BACK(lazy, 42);
+	if (
+		DA_ERRNO(lazy) == DA_SUCCESS && DA_SIZE(lazy) == 1 &&
+		DA_CAPACITY(lazy) ==
+			ALLOCATED_CAPACITY(lazy, DA_INITIAL_CAPACITY) &&
+		DA_FRONT(lazy) == 42
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(lazy, "DA_INIT");
+		printf("[ fail ]");
+	}
+	printf(" first push allocates\n");
+	DA_DESTROY(lazy);
+
+	struct {
+		int id;
+		da_type(int) list;
+	} zeroed = {0};
+	DA_INSERT(zeroed.list, DA_BEGIN(zeroed.list), 7);
+	if (DA_ERRNO(zeroed.list) == DA_SUCCESS && DA_FRONT(zeroed.list) == 7) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(zeroed.list, "DA_INIT");
+		printf("[ fail ]");
+	}
+	printf(" zero-initialised member\n");
+	DA_DESTROY(zeroed.list);
+
+	/** DA_PUSH_BACK_SLOT ************************************************/
+	printf("---------- DA_PUSH_BACK_SLOT -----------------------------\n");
+	DA_CREATE(a);
+	int* slot = NULL;
+	for (int i = 0; i < 100; ++i) {
+		DA_PUSH_BACK_SLOT(a, slot);
+		if (slot == NULL) {
+			break;
+		}
+		*slot = i;
+	}
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 100 &&
+		slot == &DA_BACK(a) && DA_FRONT(a) == 0 && DA_BACK(a) == 99
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_PUSH_BACK_SLOT");
+		printf("[ fail ]");
+	}
+	printf(" construct in place\n");
+	DA_DESTROY(a);
+
+	DA_STATIC_CREATE(fixed);
+	for (int i = 0; i < 9; ++i) {
+		DA_PUSH_BACK_SLOT(fixed, slot);
+	}
+	if (
+		DA_ERRNO(fixed) == DA_OUT_OF_MEMORY && slot == NULL &&
+		DA_SIZE(fixed) == 8
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" full\n");
+	DA_DESTROY(fixed);
+
+	/** DA_SWAP_REMOVE & DA_ERASE_IF *************************************/
+	printf("---------- DA_SWAP_REMOVE & DA_ERASE_IF ------------------\n");
+	DA_CREATE(a);
+	for (int i = 0; i < 10; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	DA_SWAP_REMOVE(a, DA_BEGIN(a) + 2);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 9 &&
+		DA_DATA(a)[2] == 9 && DA_BACK(a) == 8
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_SWAP_REMOVE");
+		printf("[ fail ]");
+	}
+	printf(" swap remove\n");
+
+	DA_SWAP_REMOVE(a, DA_END(a));
+	if (DA_ERRNO(a) == DA_OUT_OF_BOUNDS && DA_SIZE(a) == 9) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" swap remove out of bounds\n");
+
+	/* 0 1 9 3 4 5 6 7 8 -> 1 9 3 5 7 */
+	DA_ERASE_IF(a, it, *it % 2 == 0);
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 5 &&
+		DA_DATA(a)[0] == 1 && DA_DATA(a)[1] == 9 &&
+		DA_DATA(a)[2] == 3 && DA_DATA(a)[3] == 5 &&
+		DA_DATA(a)[4] == 7
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase if, stable\n");
+
+	DA_ERASE_IF(a, it, 1);
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_EMPTY(a)) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" erase all\n");
+	DA_DESTROY(a);
+
+	/** DA_ERASE_INDICES *************************************************/
+	printf("---------- DA_ERASE_INDICES ------------------------------\n");
+	DA_CREATE(a);
+	for (int i = 0; i < 10; ++i) {
+		DA_PUSH_BACK(a, i);
+	}
+	size_t unsorted[] = { 3, 1 };
+	size_t past_end[] = { 1, 10 };
+	DA_ERASE_INDICES(a, unsorted, 2);
+	res = DA_ERRNO(a) == DA_INVALID_ITERATOR;
+	DA_ERASE_INDICES(a, past_end, 2);
+	if (res && DA_ERRNO(a) == DA_OUT_OF_BOUNDS && DA_SIZE(a) == 10) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" invalid indices\n");
+
+	/* 0 1 2 3 4 5 6 7 8 9 -> 1 2 6 8 */
+	size_t drop[] = { 0, 3, 4, 4, 5, 7, 9 };
+	DA_ERASE_INDICES(a, drop, sizeof(drop) / sizeof(drop[0]));
+	if (
+		DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 4 &&
+		DA_DATA(a)[0] == 1 && DA_DATA(a)[1] == 2 &&
+		DA_DATA(a)[2] == 6 && DA_DATA(a)[3] == 8
+	) {
+		printf("[ pass ]");
+	} else {
+		DA_PERROR(a, "DA_ERASE_INDICES");
+		printf("[ fail ]");
+	}
+	printf(" erase indices\n");
+
+	DA_ERASE_INDICES(a, drop, 0);
+	if (DA_ERRNO(a) == DA_SUCCESS && DA_SIZE(a) == 4) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" no indices\n");
+	DA_DESTROY(a);
+
+	/** DA_DEFINE ********************************************************/
+	printf("---------- DA_DEFINE -------------------------------------\n");
+	int_array ints;
+	int_array_create(&ints);
+	err = DA_SUCCESS;
+	for (int i = 0; i < 100 && err == DA_SUCCESS; ++i) {
+		err = int_array_push_back(&ints, i);
+	}
+	if (
+		err == DA_SUCCESS && DA_SIZE(ints) == 100 &&
+		*int_array_at(&ints, 99) == 99
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" push_back & at\n");
+
+	if (
+		int_array_at(&ints, 100) == NULL &&
+		DA_ERRNO(ints) == DA_OUT_OF_BOUNDS &&
+		int_array_insert(&ints, 101, 0) == DA_OUT_OF_BOUNDS &&
+		int_array_erase(&ints, 100) == DA_OUT_OF_BOUNDS
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" out of bounds\n");
+
+	if (
+		int_array_insert(&ints, 0, -1) == DA_SUCCESS &&
+		int_array_erase(&ints, 1) == DA_SUCCESS &&
+		DA_SIZE(ints) == 100 && DA_FRONT(ints) == -1 &&
+		DA_DATA(ints)[1] == 1
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" insert & erase\n");
+
+	if (
+		int_array_reserve(&ints, 0) == DA_INVALID_SIZE &&
+		int_array_reserve(&ints, 1000) == DA_SUCCESS &&
+		DA_CAPACITY(ints) == ALLOCATED_CAPACITY(ints, 1000) &&
+		int_array_resize(&ints, 10) == DA_SUCCESS && DA_SIZE(ints) == 10
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reserve & resize\n");
+
+	/* a reserve that does not grow still succeeds, and says so */
+	if (
+		int_array_reserve(&ints, 0) == DA_INVALID_SIZE &&
+		int_array_reserve(&ints, 4) == DA_SUCCESS &&
+		DA_ERRNO(ints) == DA_SUCCESS
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reserve within capacity\n");
+
+	/* the macros still apply */
+	DA_PUSH_BACK(ints, 7);
+	int_array_clear(&ints);
+	if (DA_ERRNO(ints) == DA_SUCCESS && DA_EMPTY(ints)) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" clear & macros\n");
+	int_array_destroy(&ints);
+
+	/** da_any_type ******************************************************/
+	printf("---------- da_any_type -----------------------------------\n");
+	da_any_type any;
+	da_any_create(&any, sizeof(double));
+	err = DA_SUCCESS;
+	for (int i = 0; i < 100 && err == DA_SUCCESS; ++i) {
+		double value = i;
+		err = da_any_push_back(&any, &value);
+	}
+	double* first = da_any_get(&any, 0);
+	double* last = da_any_get(&any, 99);
+	if (
+		err == DA_SUCCESS && DA_SIZE(any) == 100 &&
+		first != NULL && *first == 0.0 && last != NULL && *last == 99.0
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" push_back & get\n");
+
+	if (da_any_get(&any, 100) == NULL) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" get out of bounds\n");
+
+	double front = -1.0;
+	if (
+		da_any_insert(&any, 0, &front) == DA_SUCCESS &&
+		da_any_insert(&any, 102, &front) == DA_OUT_OF_BOUNDS &&
+		da_any_erase(&any, 1) == DA_SUCCESS &&
+		da_any_erase(&any, 100) == DA_OUT_OF_BOUNDS &&
+		DA_SIZE(any) == 100 &&
+		*(double*)da_any_get(&any, 0) == -1.0 &&
+		*(double*)da_any_get(&any, 1) == 1.0
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" insert & erase\n");
+	da_any_destroy(&any);
+
+	/* elements of the array itself, while the array is full */
+	da_any_create(&any, sizeof(double));
+	da_any_reserve(&any, 4);
+	double value = 1.0;
+	while (DA_SIZE(any) < DA_CAPACITY(any)) {
+		da_any_push_back(&any, &value);
+		value += 1.0;
+	}
+	size_t full_size = DA_SIZE(any);
+	if (
+		da_any_push_back(&any, da_any_get(&any, 0)) == DA_SUCCESS &&
+		DA_SIZE(any) == full_size + 1 &&
+		*(double*)da_any_get(&any, full_size) == 1.0
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" push_back own element\n");
+
+	while (DA_SIZE(any) < DA_CAPACITY(any)) {
+		da_any_push_back(&any, &value);
+	}
+	/* 1 2 3 ... -> 2 1 2 3 ... -> 2 2 1 2 3 ... */
+	if (
+		da_any_insert(&any, 0, da_any_get(&any, 1)) == DA_SUCCESS &&
+		da_any_insert(&any, 1, da_any_get(&any, 0)) == DA_SUCCESS &&
+		*(double*)da_any_get(&any, 0) == 2.0 &&
+		*(double*)da_any_get(&any, 1) == 2.0 &&
+		*(double*)da_any_get(&any, 2) == 1.0 &&
+		*(double*)da_any_get(&any, 3) == 2.0
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" insert own element\n");
+	da_any_destroy(&any);
+	da_any_destroy(&any);
+
+	/* a size without a fixed size copy, through an allocator */
+	bytes_in_use = 0;
+	da_any_create_with(&any, 3, &tracking_allocator, &bytes_in_use);
+	if (
+		da_any_reserve(&any, 0) == DA_INVALID_SIZE &&
+		da_any_reserve(&any, 10) == DA_SUCCESS &&
+		DA_CAPACITY(any) == 10 && bytes_in_use == 30
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" reserve through allocator\n");
+
+	err = DA_SUCCESS;
+	for (int i = 0; i < 20 && err == DA_SUCCESS; ++i) {
+		unsigned char triple[3] = { i, i + 1, i + 2 };
+		err = da_any_insert(&any, 0, triple);
+	}
+	unsigned char* triple = da_any_get(&any, 19);
+	if (
+		err == DA_SUCCESS && DA_SIZE(any) == 20 &&
+		triple[0] == 0 && triple[1] == 1 && triple[2] == 2 &&
+		bytes_in_use == DA_CAPACITY(any) * 3
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" odd element size\n");
+	da_any_destroy(&any);
+	if (bytes_in_use == 0) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" destroy\n");
+
+	da_any_create(&any, 0);
+	int zero = 0;
+	if (
+		da_any_push_back(&any, &zero) == DA_INVALID_SIZE &&
+		da_any_reserve(&any, 10) == DA_INVALID_SIZE && DA_EMPTY(any)
+	) {
+		printf("[ pass ]");
+	} else {
+		printf("[ fail ]");
+	}
+	printf(" zero element size\n");
+	da_any_destroy(&any);
 
 	return 0;
 }